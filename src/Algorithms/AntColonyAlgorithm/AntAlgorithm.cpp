@@ -1,228 +1,1034 @@
 #include "AntAlgorithm.h"
 
 namespace s21 {
-void AntAlgorithm::SetData(S21Matrix &matrix, int N) {
-    matrix_ = std::move(matrix);
-    count_of_nodes_ = matrix_.get_rows();
+namespace {
+const double kMinDistance = 1e-3;
+const char kStateMagic[] = "S21ANT2";
+
+template <class T>
+void WriteValue(std::ostream &out, const T &value) {
+    out.write(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+template <class T>
+bool ReadValue(std::istream &in, T &value) {
+    return (bool)in.read(reinterpret_cast<char *>(&value), sizeof(T));
+}
+}  // namespace
+
+void AntAlgorithm::SetData(const S21Matrix &matrix, int N) {
+    S21Matrix distances(matrix);
+    FillEmptyNodes(distances);
+    SetData(std::make_shared<MatrixDistances>(std::move(distances)), N);
+}
+
+void AntAlgorithm::SetData(std::shared_ptr<DistanceProvider> graph, int N) {
+    graph_ = std::move(graph);
+    count_of_nodes_ = graph_->get_size();
     this->N = N;
+    colonies_.clear();
+    graph_changed_ = false;
+    CheckStorage(parameters_);
+    CalculateAllShortestPaths();
+    CalculateCandidates();
+    CalculateHeuristic();
+}
+
+void AntAlgorithm::SetParameters(const AntParameters &parameters) {
+    if (parameters.threads < 1 || parameters.ants < 1) {
+        throw "Ant parameters error: number of threads and ants must be greater than 0";
+    } else if (parameters.evaporation < 0.0 || parameters.evaporation > 1.0) {
+        throw "Ant parameters error: evaporation must be in range [0, 1]";
+    } else if (parameters.Q <= 0.0 || parameters.initial_pheromone <= 0.0) {
+        throw "Ant parameters error: Q and initial pheromone must be greater than 0";
+    } else if (parameters.candidates < 0) {
+        throw "Ant parameters error: count of candidates must not be negative";
+    } else if (parameters.system == AntSystem::kMaxMin && parameters.evaporation == 0.0) {
+        throw "Ant parameters error: evaporation of MAX-MIN Ant System must be greater than 0";
+    } else if (parameters.stagnation_iterations < 1 || parameters.exploitation < 0.0 ||
+               parameters.exploitation > 1.0 || parameters.local_evaporation < 0.0 ||
+               parameters.local_evaporation > 1.0) {
+        throw "Ant parameters error: wrong parameters of MAX-MIN Ant System or Ant Colony System";
+    } else if (parameters.islands < 1 || parameters.migration_interval < 1 ||
+               parameters.migration_blend < 0.0 || parameters.migration_blend > 1.0) {
+        throw "Ant parameters error: wrong parameters of islands";
+    } else if (parameters.tournament_size < 1) {
+        throw "Ant parameters error: tournament size must be greater than 0";
+    } else if (parameters.time_budget < 0.0 || parameters.target_length < 0.0 ||
+               parameters.stagnation_limit < 0) {
+        throw "Ant parameters error: stopping criteria must not be negative";
+    }
+    CheckStorage(parameters);
+    bool heuristic_changed =
+        parameters.beta != parameters_.beta || parameters.pheromone_storage != parameters_.pheromone_storage;
+    bool candidates_changed = parameters.candidates != parameters_.candidates ||
+                              parameters.cache_candidate_edges != parameters_.cache_candidate_edges;
+    parameters_ = parameters;
+    if (heuristic_changed || candidates_changed) {
+        // Pheromones of another layout can't be resumed
+        colonies_.clear();
+    }
+    if (candidates_changed && count_of_nodes_ > 0) {
+        CalculateCandidates();
+    }
+    if ((heuristic_changed || candidates_changed) && count_of_nodes_ > 0) {
+        CalculateHeuristic();
+    }
+}
+
+void AntAlgorithm::SetIterations(int N) { this->N = N; }
+
+void AntAlgorithm::UpdateEdge(int from, int to, double distance) {
+    if (from < 0 || to < 0 || from >= count_of_nodes_ || to >= count_of_nodes_ || from == to ||
+        distance <= 0.0) {
+        throw "Ant update error: wrong edge or distance";
+    }
+    bool symmetric = parameters_.pheromone_storage == EdgeStorage::kSymmetric;
+    graph_->SetDistance(from, to, distance);
+    if (symmetric) {
+        graph_->SetDistance(to, from, distance);
+    }
+    std::int64_t index = heuristic_.Index(from, to);
+    if (index != -1) {
+        heuristic_.Set(index, GetHeuristic(from, to));
+        for (auto &colony : colonies_) {
+            colony.choice_info.Set(index, GetChoiceInfo(colony.pheromones[index], heuristic_[index]));
+        }
+    }
+    graph_changed_ = true;
+}
+
+void AntAlgorithm::CheckStorage(const AntParameters &parameters) const {
+    if (graph_ && parameters.pheromone_storage == EdgeStorage::kSymmetric && !graph_->is_symmetric()) {
+        throw "Ant parameters error: symmetric pheromone storage needs a symmetric graph";
+    }
 }
 
-void AntAlgorithm::SolveWithoutUsingParallelism() { MainIteration(false); }
+const AntParameters &AntAlgorithm::GetParameters() const { return parameters_; }
+
+void AntAlgorithm::SetSeed(std::uint64_t seed) { parameters_.seed = seed; }
+
+void AntAlgorithm::SolveWithoutUsingParallelism() { MainIteration(1); }
 
-void AntAlgorithm::SolveUsingParallelism() { MainIteration(true); }
+void AntAlgorithm::SolveUsingParallelism() { MainIteration(parameters_.threads); }
+
+void AntAlgorithm::SolveUsingThreads(int threads) { MainIteration(std::max(1, threads)); }
 
 TsmResult &AntAlgorithm::GetResult() { return shortest_path_; }
 
-void AntAlgorithm::FillEmptyNodes() {
-    double max = matrix_(0, 0);
-    for (int i = 0; i < matrix_.get_rows(); i++) {
-        for (int j = 0; j < matrix_.get_cols(); j++) {
-            max = std::max(max, matrix_(i, j));
+void AntAlgorithm::SetProgressCallback(std::function<void(const AntProgress &)> callback) {
+    progress_callback_ = std::move(callback);
+}
+
+AntProgress AntAlgorithm::GetProgress() const {
+    std::lock_guard<std::mutex> lock(progress_mutex_);
+    return progress_;
+}
+
+void AntAlgorithm::Cancel() { Stop(StopReason::kCancelled); }
+
+double AntAlgorithm::GetLocalSearchTime() const { return local_search_time_; }
+
+const EdgeMatrix &AntAlgorithm::GetPheromones(int island) const {
+    if (island < 0 || island >= (int)colonies_.size()) {
+        throw "Ant state error: there is no such island";
+    }
+    return colonies_[island].pheromones;
+}
+
+TsmResult AntAlgorithm::GetIslandBest(int island) const {
+    if (island < 0 || island >= (int)colonies_.size()) {
+        throw "Ant state error: there is no such island";
+    }
+    TsmResult best = colonies_[island].best;
+    for (int &vertex : best.vertices) vertex++;
+    return best;
+}
+
+void AntAlgorithm::FillEmptyNodes(S21Matrix &matrix) {
+    double max = matrix(0, 0);
+    for (int i = 0; i < matrix.get_rows(); i++) {
+        for (int j = 0; j < matrix.get_cols(); j++) {
+            max = std::max(max, matrix(i, j));
         }
     }
-    for (int i = 0; i < matrix_.get_rows(); i++) {
-        for (int j = 0; j < matrix_.get_cols(); j++) {
-            if (i != j && matrix_(i, j) == 0.0) {
+    for (int i = 0; i < matrix.get_rows(); i++) {
+        for (int j = 0; j < matrix.get_cols(); j++) {
+            if (i != j && matrix(i, j) == 0.0) {
                 max += 10.0;
-                matrix_(i, j) = max;
+                matrix(i, j) = max;
             }
         }
     }
 }
 
-void AntAlgorithm::MainIteration(bool multithreading) {
-    shortest_path_ = TsmResult({}, -1.0);
-    FillEmptyNodes();
-    pheromones_ = pheromones_delta_ = S21Matrix(count_of_nodes_, count_of_nodes_);
-    for (int i = 0; i < matrix_.get_rows(); ++i) {
-        for (int j = 0; j < matrix_.get_cols(); ++j) {
-            if (matrix_(i, j) != 0.0) {
-                pheromones_(i, j) = 0.2;
-            }
-        }
-    }
-    if (multithreading) {
-        std::thread it1, it2, it3, it4;
-        it1 = std::thread(&AntAlgorithm::AntColonyAlgorithm, this, 300);
-        it2 = std::thread(&AntAlgorithm::AntColonyAlgorithm, this, 300);
-        it3 = std::thread(&AntAlgorithm::AntColonyAlgorithm, this, 300);
-        it4 = std::thread(&AntAlgorithm::AntColonyAlgorithm, this, 300);
-        it1.join();
-        it2.join();
-        it3.join();
-        it4.join();
+void AntAlgorithm::CalculateHeuristic() {
+    heuristic_ = EdgeMatrix(parameters_.pheromone_storage, count_of_nodes_, candidates_, candidates_count_);
+    for (int i = 0; i < count_of_nodes_; i++) {
+        for (std::int64_t index = heuristic_.RowBegin(i); index < heuristic_.RowEnd(i); index++) {
+            heuristic_.Set(index, GetHeuristic(i, heuristic_.Column(i, index)));
+        }
+    }
+}
+
+double AntAlgorithm::GetHeuristic(int from, int to) const {
+    if (from == to) {
+        return 0.0;
+    }
+    // Coordinates of different nodes may coincide
+    double distance = std::max(graph_->Distance(from, to), kMinDistance);
+    return parameters_.beta == 1.0 ? 1.0 / distance : std::pow(1.0 / distance, parameters_.beta);
+}
+
+double AntAlgorithm::GetChoiceInfo(double pheromone, double heuristic) const {
+    return (parameters_.alpha == 1.0 ? pheromone : std::pow(pheromone, parameters_.alpha)) * heuristic;
+}
+
+void AntAlgorithm::CalculateChoiceInfo(Colony &colony, int start_row, int end_row) {
+    for (int i = start_row; i < end_row; i++) {
+        for (std::int64_t index = heuristic_.RowBegin(i); index < heuristic_.RowEnd(i); index++) {
+            colony.choice_info.Set(index, GetChoiceInfo(colony.pheromones[index], heuristic_[index]));
+        }
+    }
+}
+
+void AntAlgorithm::MainIteration(int threads) {
+    start_ = std::chrono::steady_clock::now();
+    stop_ = false;
+    {
+        std::lock_guard<std::mutex> lock(progress_mutex_);
+        progress_ = AntProgress();
+    }
+    if (graph_changed_) {
+        // Candidate storage keeps pheromones by the positions in the lists, so its lists stay
+        CalculateAllShortestPaths();
+        if (heuristic_.get_storage() != EdgeStorage::kCandidates) {
+            CalculateCandidates();
+        }
+        graph_changed_ = false;
+    }
+    double initial_pheromone = GetInitialPheromone();
+    int islands = parameters_.islands;
+    if (parameters_.warm_start && CanResume()) {
+        for (auto &colony : colonies_) {
+            ResumeColony(colony);
+        }
+    } else {
+        InitColonies(initial_pheromone);
+    }
+    if (islands == 1) {
+        AntColonyAlgorithm(colonies_[0], threads, 0, N, true);
     } else {
-        AntColonyAlgorithm(1200);
+        // Islands take no locks between migrations: a worker runs an island single-threaded
+        for (int first = 0; first < N && !stop_; first += parameters_.migration_interval) {
+            int end = std::min(N, first + parameters_.migration_interval);
+            std::atomic<int> next_island(0);
+            std::vector<int> done(islands);
+            Executor::Instance().ParallelRun(std::min(threads, islands), [&](int) {
+                for (int i = next_island++; i < islands; i = next_island++) {
+                    done[i] = AntColonyAlgorithm(colonies_[i], 1, first, end, false);
+                }
+            });
+            UpdateProgress(first + *std::max_element(done.begin(), done.end()));
+            if (end < N && !stop_) {
+                Migrate();
+            }
+        }
+    }
+    Stop(StopReason::kIterations);
+    shortest_path_ = TsmResult({}, -1.0);
+    local_search_time_ = 0.0;
+    for (auto &colony : colonies_) {
+        // An island cancelled before its first iteration has no tour
+        if (shortest_path_.distance == -1.0 ||
+            (colony.best.distance != -1.0 && colony.best.distance < shortest_path_.distance)) {
+            shortest_path_ = colony.best;
+        }
+        for (auto &chunk : colony.chunks) {
+            local_search_time_ += chunk.local_search_time;
+        }
     }
     for (size_t i = 0; i < shortest_path_.vertices.size(); ++i) {
         shortest_path_.vertices[i]++;
     }
 }
 
-void AntAlgorithm::AntColonyAlgorithm(int end) {
-    for (int iteration = 0; iteration < N; iteration++) {
-        if (iteration > 0) {
-            ApplyDeltaToPheromones();
+void AntAlgorithm::InitColony(Colony &colony, double initial_pheromone, std::uint64_t seed) {
+    colony.seed = seed;
+    colony.chunks.resize((parameters_.ants + kAntsInChunk - 1) / kAntsInChunk);
+    AllocateTours(colony);
+    colony.tau_max = initial_pheromone;
+    colony.tau_min = initial_pheromone / (2.0 * count_of_nodes_);
+    EdgeMatrix &pheromones = colony.pheromones;
+    pheromones = EdgeMatrix(parameters_.pheromone_storage, count_of_nodes_, candidates_, candidates_count_);
+    pheromones.background = initial_pheromone;
+    for (int i = 0; i < count_of_nodes_; ++i) {
+        for (std::int64_t index = pheromones.RowBegin(i); index < pheromones.RowEnd(i); ++index) {
+            if (pheromones.Column(i, index) != i) {
+                pheromones.Set(index, initial_pheromone);
+            }
+        }
+    }
+    colony.choice_info = pheromones;
+    CalculateChoiceInfo(colony, 0, count_of_nodes_);
+}
+
+void AntAlgorithm::InitColonies(double initial_pheromone) {
+    colonies_.assign(parameters_.islands, Colony());
+    for (int i = 0; i < parameters_.islands; ++i) {
+        InitColony(colonies_[i], initial_pheromone,
+                   i == 0 ? parameters_.seed : Xoshiro256::StreamSeed(parameters_.seed, ~(std::uint64_t)i));
+    }
+}
+
+bool AntAlgorithm::CanResume() const {
+    return (int)colonies_.size() == parameters_.islands &&
+           colonies_[0].pheromones.get_size() == count_of_nodes_ &&
+           colonies_[0].pheromones.get_storage() == heuristic_.get_storage();
+}
+
+void AntAlgorithm::ResumeColony(Colony &colony) {
+    colony.chunks.assign((parameters_.ants + kAntsInChunk - 1) / kAntsInChunk, Chunk());
+    AllocateTours(colony);
+    // Edges may have changed since the best tour was found
+    if (colony.best.distance != -1.0) {
+        colony.best.distance = GetTourLength(colony.best.vertices);
+        colony.deposit_tour = colony.best;
+        if (parameters_.system == AntSystem::kMaxMin) {
+            colony.tau_max = parameters_.Q / (parameters_.evaporation * colony.best.distance);
+            colony.tau_min = colony.tau_max / (2.0 * count_of_nodes_);
+        }
+    }
+    colony.stagnation = 0;
+    colony.reset_pheromones = false;
+    CalculateChoiceInfo(colony, 0, count_of_nodes_);
+}
+
+double AntAlgorithm::GetTourLength(const std::vector<int> &tour) const {
+    double length = 0.0;
+    for (size_t k = 1; k < tour.size(); ++k) {
+        length += graph_->Distance(tour[k - 1], tour[k]);
+    }
+    return length;
+}
+
+void AntAlgorithm::SaveState(std::ostream &out) const {
+    if (colonies_.empty()) {
+        throw "Ant checkpoint error: there are no pheromones to save";
+    }
+    out.write(kStateMagic, sizeof(kStateMagic));
+    WriteValue(out, (std::int32_t)count_of_nodes_);
+    WriteValue(out, (std::int32_t)heuristic_.get_storage());
+    WriteValue(out, (std::int32_t)candidates_count_);
+    WriteValue(out, (std::int32_t)colonies_.size());
+    for (int candidate : candidates_) {
+        WriteValue(out, (std::int32_t)candidate);
+    }
+    for (auto &colony : colonies_) {
+        WriteValue(out, colony.tau_min);
+        WriteValue(out, colony.tau_max);
+        WriteValue(out, colony.best.distance);
+        WriteValue(out, (std::int32_t)colony.best.vertices.size());
+        for (int vertex : colony.best.vertices) {
+            WriteValue(out, (std::int32_t)vertex);
+        }
+        colony.pheromones.Save(out);
+    }
+}
+
+bool AntAlgorithm::LoadState(std::istream &in) {
+    char magic[sizeof(kStateMagic)];
+    std::int32_t nodes, storage, candidates_count, islands;
+    if (!in.read(magic, sizeof(magic)) || !std::equal(magic, magic + sizeof(magic), kStateMagic) ||
+        !ReadValue(in, nodes) || !ReadValue(in, storage) || !ReadValue(in, candidates_count) ||
+        !ReadValue(in, islands) || nodes != count_of_nodes_ || storage != (int)heuristic_.get_storage() ||
+        candidates_count != candidates_count_ || islands != parameters_.islands) {
+        return false;
+    }
+    for (int candidate : candidates_) {
+        std::int32_t value;
+        if (!ReadValue(in, value) || value != candidate) return false;
+    }
+    std::vector<Colony> colonies(std::move(colonies_));
+    InitColonies(GetInitialPheromone());
+    for (auto &colony : colonies_) {
+        std::int32_t size;
+        if (!ReadValue(in, colony.tau_min) || !ReadValue(in, colony.tau_max) ||
+            !ReadValue(in, colony.best.distance) || !ReadValue(in, size) || size < 0 ||
+            size > 2 * nodes + 1) {
+            colonies_ = std::move(colonies);
+            return false;
+        }
+        colony.best.vertices.resize(size);
+        for (int &vertex : colony.best.vertices) {
+            std::int32_t value;
+            if (!ReadValue(in, value) || value < 0 || value >= nodes) {
+                colonies_ = std::move(colonies);
+                return false;
+            }
+            vertex = value;
+        }
+        if (!colony.pheromones.Load(in)) {
+            colonies_ = std::move(colonies);
+            return false;
+        }
+        CalculateChoiceInfo(colony, 0, count_of_nodes_);
+    }
+    return true;
+}
+
+double AntAlgorithm::GetInitialPheromone() {
+    double length = GetNearestNeighbourLength();
+    if (length <= 0.0 || parameters_.system == AntSystem::kAntSystem) {
+        return parameters_.initial_pheromone;
+    } else if (parameters_.system == AntSystem::kMaxMin) {
+        return parameters_.Q / (parameters_.evaporation * length);
+    }
+    tau0_ = parameters_.Q / (count_of_nodes_ * length);
+    return tau0_;
+}
+
+double AntAlgorithm::GetNearestNeighbourLength() const {
+    std::vector<char> visited(count_of_nodes_);
+    double length = 0.0;
+    int cur_pos = 0;
+    visited[0] = 1;
+    for (int step = 1; step < count_of_nodes_; ++step) {
+        int next = -1;
+        double next_distance = 0.0;
+        for (int j = 0; j < count_of_nodes_; ++j) {
+            double distance = graph_->Distance(cur_pos, j);
+            if (!visited[j] && (next == -1 || distance < next_distance)) {
+                next = j;
+                next_distance = distance;
+            }
+        }
+        length += next_distance;
+        visited[next] = 1;
+        cur_pos = next;
+    }
+    return length + home_distances_[cur_pos];
+}
+
+void AntAlgorithm::Migrate() {
+    int islands = colonies_.size();
+    auto source = [&](int island) { return (island + islands - 1) % islands; };
+    if (parameters_.migration == MigrationMode::kBestTour) {
+        int best = 0;
+        for (int i = 1; i < islands; ++i) {
+            if (colonies_[i].best.distance < colonies_[best].best.distance) best = i;
+        }
+        std::vector<TsmResult> migrants(islands);
+        for (int i = 0; i < islands; ++i) {
+            migrants[i] = colonies_[parameters_.topology == MigrationTopology::kRing ? source(i) : best].best;
+        }
+        // Better tour replaces the best tour of the island and is reinforced in its pheromones
+        for (int i = 0; i < islands; ++i) {
+            Colony &colony = colonies_[i];
+            if (migrants[i].distance < colony.best.distance) {
+                colony.best = migrants[i];
+                colony.deposit_tour = migrants[i];
+                AddPheromone(colony, migrants[i], parameters_.Q / migrants[i].distance);
+            }
+        }
+    } else {
+        std::vector<EdgeMatrix> old_pheromones;
+        for (auto &colony : colonies_) {
+            old_pheromones.push_back(colony.pheromones);
+        }
+        const double blend = parameters_.migration_blend;
+        for (int island = 0; island < islands; ++island) {
+            EdgeMatrix &pheromones = colonies_[island].pheromones;
+            // Index -1 stands for the background value
+            for (std::int64_t index = -1; index < pheromones.get_count(); ++index) {
+                auto value = [index](const EdgeMatrix &matrix) {
+                    return index == -1 ? matrix.background : matrix[index];
+                };
+                double other = 0.0;
+                if (parameters_.topology == MigrationTopology::kRing) {
+                    other = value(old_pheromones[source(island)]);
+                } else {
+                    for (auto &old : old_pheromones) other += value(old);
+                    other /= islands;
+                }
+                double blended = (1.0 - blend) * value(pheromones) + blend * other;
+                if (index == -1) {
+                    pheromones.background = blended;
+                } else {
+                    pheromones.Set(index, blended);
+                }
+            }
+            Colony &colony = colonies_[island];
+            CalculateChoiceInfo(colony, 0, count_of_nodes_);
+        }
+    }
+}
+
+void AntAlgorithm::AddPheromone(Colony &colony, const TsmResult &tour, double amount) {
+    for (size_t k = 1; k < tour.vertices.size(); ++k) {
+        std::int64_t index = colony.pheromones.Index(tour.vertices[k - 1], tour.vertices[k]);
+        if (index == -1) continue;
+        double pheromone = colony.pheromones[index] + amount;
+        if (parameters_.system == AntSystem::kMaxMin) {
+            pheromone = std::min(pheromone, colony.tau_max);
         }
-        BuildPath(end);
+        colony.pheromones.Set(index, pheromone);
     }
+    CalculateChoiceInfo(colony, 0, count_of_nodes_);
 }
 
-void AntAlgorithm::ApplyDeltaToPheromones() {
-    const double vape = 0.5;
-    for (int i = 0; i < matrix_.get_rows(); i++) {
-        mt.lock();
-        for (int j = 0; j < matrix_.get_cols(); j++) {
-            if (matrix_(i, j) != 0.0) {
-                pheromones_(i, j) = vape * pheromones_(i, j) + pheromones_delta_(i, j);
+int AntAlgorithm::AntColonyAlgorithm(Colony &colony, int threads, int first_iteration, int end_iteration,
+                                     bool report) {
+    int ants = parameters_.ants;
+    std::vector<Chunk> &chunks = colony.chunks;
+    std::vector<AntScratch> scratches(threads, AntScratch(count_of_nodes_));
+    std::vector<LocalSearch> local_searches(
+        threads, LocalSearch(*graph_, home_distances_, candidates_, candidates_count_));
+    SplitRows(colony, threads);
+    int iteration = first_iteration;
+    for (; iteration < end_iteration && !stop_; iteration++) {
+        std::atomic<int> next_chunk(0);
+        Executor::Instance().ParallelRun(threads, [&](int id) {
+            for (int c = next_chunk++; c < (int)chunks.size(); c = next_chunk++) {
+                int first_ant = c * kAntsInChunk;
+                BuildPath(colony, scratches[id], local_searches[id], chunks[c], first_ant,
+                          std::min(kAntsInChunk, ants - first_ant), iteration);
             }
+        });
+        UpdateBestTours(colony);
+        // All tours of the iteration are built: deposits are reduced part by part in parallel
+        Executor::Instance().ParallelRun(threads, [&](int id) { ApplyDeltaToPheromones(colony, id); });
+        if (report) {
+            UpdateProgress(iteration + 1);
+        } else if (parameters_.time_budget > 0.0 && GetElapsed() >= parameters_.time_budget) {
+            Stop(StopReason::kTimeBudget);
+        }
+    }
+    return iteration - first_iteration;
+}
+
+void AntAlgorithm::UpdateProgress(int iteration) {
+    std::unique_lock<std::mutex> lock(progress_mutex_);
+    const Colony *best = &colonies_[0];
+    double mean = 0.0;
+    progress_.iteration_best = colonies_[0].iteration_best;
+    for (auto &colony : colonies_) {
+        if (colony.best.distance != -1.0 &&
+            (best->best.distance == -1.0 || colony.best.distance < best->best.distance)) {
+            best = &colony;
         }
-        mt.unlock();
+        progress_.iteration_best = std::min(progress_.iteration_best, colony.iteration_best);
+        mean += colony.iteration_mean;
     }
+    progress_.iteration_mean = mean / colonies_.size();
+    if (progress_.best.distance == -1.0 ||
+        (best->best.distance != -1.0 && best->best.distance < progress_.best.distance)) {
+        progress_.best = best->best;
+        for (int &vertex : progress_.best.vertices) vertex++;
+        progress_.stagnation = 0;
+    } else {
+        progress_.stagnation += iteration - progress_.iteration;
+    }
+    progress_.iteration = iteration;
+    progress_.elapsed = GetElapsed();
+    lock.unlock();
+
+    if (parameters_.target_length > 0.0 && best->best.distance != -1.0 &&
+        best->best.distance <= parameters_.target_length) {
+        Stop(StopReason::kTargetLength);
+    } else if (parameters_.stagnation_limit > 0 && progress_.stagnation >= parameters_.stagnation_limit) {
+        Stop(StopReason::kStagnation);
+    } else if (parameters_.time_budget > 0.0 && progress_.elapsed >= parameters_.time_budget) {
+        Stop(StopReason::kTimeBudget);
+    }
+    if (progress_callback_) {
+        progress_callback_(GetProgress());
+    }
+}
+
+void AntAlgorithm::Stop(StopReason reason) {
+    std::lock_guard<std::mutex> lock(progress_mutex_);
+    // The first reason wins, so a late Cancel does not hide why the solve stopped
+    if (progress_.stop_reason == StopReason::kRunning) {
+        progress_.stop_reason = reason;
+    }
+    stop_ = true;
+}
+
+double AntAlgorithm::GetElapsed() const {
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start_;
+    return elapsed.count();
 }
 
-void AntAlgorithm::BuildPath(int end) {
-    TsmResult min = TsmResult({}, -1.0);
-    S21Matrix event(count_of_nodes_, count_of_nodes_);
-    for (int start_ind = 0; start_ind < end; start_ind++) {
-        std::vector<int> visited;
-        std::set<int> available_nodes;
-        int ants_path = 0;
-        for (int i = 0; i < count_of_nodes_; ++i) available_nodes.insert(i);
-        int current_pos = 0;
-        while (true) {
-            visited.push_back(current_pos);
-            available_nodes.erase(current_pos);
-            if (available_nodes.size() == 0) break;
-            event.FillWithDigit(0.0);
-            for (int j = 1; j < count_of_nodes_ && available_nodes.size() > 1; ++j) {
-                if (matrix_(current_pos, j) != 0.0) {
-                    event(current_pos, j) = GetEventPossibility(current_pos, j, available_nodes);
+void AntAlgorithm::UpdateBestTours(Colony &colony) {
+    // Minima of the chunks are reduced in chunk order, so the choice between equal tours does not
+    // depend on threads. Only the winner is copied out of the tour buffer
+    const std::vector<double> &lengths = colony.tour_lengths;
+    int iteration_best = colony.chunks[0].best;
+    double length_sum = 0.0;
+    int tours = parameters_.ants;
+    for (int ant = 0; ant < parameters_.ants; ++ant) {
+        length_sum += lengths[ant];
+    }
+    for (size_t c = 0; c < colony.chunks.size(); ++c) {
+        const Chunk &chunk = colony.chunks[c];
+        if (lengths[chunk.best] < lengths[iteration_best]) {
+            iteration_best = chunk.best;
+        }
+        if (chunk.improved) {
+            length_sum += lengths[parameters_.ants + c];
+            tours++;
+        }
+    }
+    colony.iteration_best = lengths[iteration_best];
+    colony.iteration_mean = length_sum / tours;
+    bool improved = colony.best.distance == -1.0 || lengths[iteration_best] < colony.best.distance;
+    if (improved) {
+        colony.best = GetFullPath(colony, iteration_best);
+        colony.stagnation = 0;
+    } else {
+        colony.stagnation++;
+    }
+    if (parameters_.system == AntSystem::kMaxMin) {
+        if (colony.best.distance > 0.0) {
+            colony.tau_max = parameters_.Q / (parameters_.evaporation * colony.best.distance);
+            colony.tau_min = colony.tau_max / (2.0 * count_of_nodes_);
+        }
+        colony.reset_pheromones = colony.stagnation >= parameters_.stagnation_iterations;
+        if (colony.reset_pheromones) {
+            colony.stagnation = 0;
+        }
+        bool best_so_far = parameters_.deposit_best_so_far || improved;
+        colony.deposit_tour = best_so_far ? colony.best : GetFullPath(colony, iteration_best);
+    } else if (parameters_.system == AntSystem::kColonySystem) {
+        colony.deposit_tour = colony.best;
+    }
+    // Edges that are not stored only evaporate, ACS leaves them untouched
+    double &background = colony.pheromones.background;
+    if (parameters_.system != AntSystem::kColonySystem) {
+        background = colony.reset_pheromones ? colony.tau_max : background * (1.0 - parameters_.evaporation);
+    }
+    if (parameters_.system == AntSystem::kMaxMin) {
+        background = std::min(colony.tau_max, std::max(colony.tau_min, background));
+    }
+}
+
+void AntAlgorithm::SplitRows(Colony &colony, int parts) const {
+    colony.parts = parts;
+    colony.row_parts.resize(count_of_nodes_);
+    for (int part = 0; part < parts; ++part) {
+        int end = colony.pheromones.RowSplit(part + 1, parts);
+        for (int row = colony.pheromones.RowSplit(part, parts); row < end; ++row) {
+            colony.row_parts[row] = part;
+        }
+    }
+}
+
+void AntAlgorithm::ScatterDeposits(Colony &colony, Chunk &chunk, int row) const {
+    const EdgeMatrix &pheromones = colony.pheromones;
+    const size_t size = count_of_nodes_;
+    const int *tour = &colony.tours[row * size];
+    double amount = parameters_.Q / colony.path_lengths[row];
+    auto add = [&](int from, int to) {
+        std::int64_t index = pheromones.Index(from, to);
+        if (index != -1) {
+            chunk.deposits[colony.row_parts[pheromones.Row(from, to)]].push_back({index, amount});
+        }
+    };
+    for (size_t k = 1; k < size; ++k) {
+        add(tour[k - 1], tour[k]);
+    }
+    // Edges of the way back home, walked from home by the predecessors
+    int last = tour[size - 1];
+    if (predecessors_.empty()) {
+        if (last != 0) add(last, 0);
+    } else {
+        for (int i = 0; i != last;) {
+            int previous = predecessors_[last * size + i];
+            add(previous, i);
+            i = previous;
+        }
+    }
+}
+
+void AntAlgorithm::ApplyDeltaToPheromones(Colony &colony, int part) {
+    const double vape = 1.0 - parameters_.evaporation;
+    EdgeMatrix &pheromones = colony.pheromones;
+    const int start_row = pheromones.RowSplit(part, colony.parts);
+    const int end_row = pheromones.RowSplit(part + 1, colony.parts);
+    // Index of the stored edge if its row belongs to this worker, -1 otherwise
+    auto index_in_rows = [&](int from, int to) -> std::int64_t {
+        int row = pheromones.Row(from, to);
+        return row >= start_row && row < end_row ? pheromones.Index(from, to) : -1;
+    };
+    auto for_each_edge = [&](const std::function<double(double)> &update) {
+        for (int i = start_row; i < end_row; i++) {
+            for (std::int64_t index = pheromones.RowBegin(i); index < pheromones.RowEnd(i); index++) {
+                if (pheromones.Column(i, index) != i) {
+                    pheromones.Set(index, update(pheromones[index]));
                 }
             }
-            int old_pos = current_pos;
-            current_pos = GetNextNode(current_pos, available_nodes, event);
-            ants_path += matrix_(old_pos, current_pos);
         }
-        TsmResult tmp = GetFullPath(visited);
-        if (min.distance == -1.0 || tmp.distance < min.distance) {
-            min = tmp;
+    };
+    if (parameters_.system == AntSystem::kColonySystem) {
+        // Every pass of an ant moves the pheromone towards tau0, so only the count of passes matters
+        for (auto &chunk : colony.chunks) {
+            for (const LocalUpdate &update : chunk.local_updates[part]) {
+                double kept = std::pow(1.0 - parameters_.local_evaporation, update.count);
+                pheromones.Set(update.index, tau0_ + (pheromones[update.index] - tau0_) * kept);
+            }
+        }
+    } else {
+        for_each_edge(
+            [&](double pheromone) { return colony.reset_pheromones ? colony.tau_max : pheromone * vape; });
+    }
+    if (parameters_.system == AntSystem::kAntSystem) {
+        // Buckets are read in chunk order and hold the tours of a chunk in the order of ants, so the
+        // sums do not depend on thread timing or on the count of parts
+        for (auto &chunk : colony.chunks) {
+            for (const Deposit &deposit : chunk.deposits[part]) {
+                pheromones.Set(deposit.index, pheromones[deposit.index] + deposit.amount);
+            }
+        }
+    } else if (!colony.reset_pheromones) {
+        // ACS evaporates only the edges of the best tour
+        std::vector<int> &tour = colony.deposit_tour.vertices;
+        double amount = parameters_.Q / colony.deposit_tour.distance;
+        for (size_t k = 1; k < tour.size(); ++k) {
+            std::int64_t index = index_in_rows(tour[k - 1], tour[k]);
+            if (index != -1) {
+                pheromones.Set(index, parameters_.system == AntSystem::kColonySystem
+                                          ? vape * pheromones[index] + parameters_.evaporation * amount
+                                          : pheromones[index] + amount);
+            }
         }
-        IncreaseDelta(ants_path, visited);
     }
-    mt.lock();
-    if (shortest_path_.distance == -1 || min.distance < shortest_path_.distance) {
-        shortest_path_ = min;
+    if (parameters_.system == AntSystem::kMaxMin) {
+        for_each_edge(
+            [&](double pheromone) { return std::min(colony.tau_max, std::max(colony.tau_min, pheromone)); });
     }
-    mt.unlock();
+    CalculateChoiceInfo(colony, start_row, end_row);
 }
 
-double AntAlgorithm::GetEventPossibility(int rows, int cols, std::set<int> &nodes) {
-    double denominator = 0.0;
-    for (auto iterator : nodes) {
-        if (matrix_(rows, iterator) != 0.0) {
-            denominator += pheromones_(rows, iterator) * (1.0 / matrix_(rows, iterator));
+AntAlgorithm::AntScratch::AntScratch(int count_of_nodes)
+    : position(count_of_nodes, -1),
+      choices(count_of_nodes),
+      weights(count_of_nodes),
+      slots(count_of_nodes),
+      prefix(count_of_nodes),
+      prefix_float(count_of_nodes) {
+    visited.reserve(2 * count_of_nodes);
+    unvisited.reserve(count_of_nodes);
+}
+
+void AntAlgorithm::AntScratch::Reset() {
+    visited.clear();
+    unvisited.clear();
+    for (size_t i = 0; i < position.size(); ++i) {
+        position[i] = i;
+        unvisited.push_back(i);
+    }
+}
+
+void AntAlgorithm::AntScratch::Visit(int node) {
+    visited.push_back(node);
+    int ind = position[node];
+    int last = unvisited.back();
+    unvisited[ind] = last;
+    position[last] = ind;
+    unvisited.pop_back();
+    position[node] = -1;
+}
+
+void AntAlgorithm::BuildPath(Colony &colony, AntScratch &scratch, LocalSearch &local_search, Chunk &chunk,
+                             int first_ant, int end, int iteration) {
+    const size_t size = count_of_nodes_;
+    // Buckets keep their memory between iterations
+    chunk.deposits.resize(colony.parts);
+    chunk.local_updates.resize(colony.parts);
+    for (int part = 0; part < colony.parts; ++part) {
+        chunk.deposits[part].clear();
+        chunk.local_updates[part].clear();
+    }
+    chunk.improved = false;
+    scratch.local_updates.clear();
+    for (int ant = first_ant; ant < first_ant + end; ant++) {
+        // Every ant has its own random stream, so the tour depends only on the seed and the ant number
+        std::uint64_t stream = (std::uint64_t)iteration * parameters_.ants + ant;
+        double ants_path = BuildAntPath(colony, scratch, Xoshiro256::StreamSeed(colony.seed, stream));
+        if (parameters_.local_search == LocalSearchMode::kAllTours) {
+            ants_path = ImproveTour(local_search, scratch.visited, chunk);
+        }
+        std::copy(scratch.visited.begin(), scratch.visited.end(), colony.tours.begin() + ant * size);
+        colony.path_lengths[ant] = ants_path;
+    }
+    chunk.best = EvaluateTours(colony, first_ant, first_ant + end);
+    // Improved best tour of the chunk deposits pheromone in addition to the tours of all ants
+    if (parameters_.local_search == LocalSearchMode::kIterationBest) {
+        int row = parameters_.ants + first_ant / kAntsInChunk;
+        auto best = colony.tours.begin() + chunk.best * size;
+        scratch.visited.assign(best, best + size);
+        colony.path_lengths[row] = ImproveTour(local_search, scratch.visited, chunk);
+        std::copy(scratch.visited.begin(), scratch.visited.end(), colony.tours.begin() + row * size);
+        chunk.improved = true;
+        EvaluateTours(colony, row, row + 1);
+        if (colony.tour_lengths[row] < colony.tour_lengths[chunk.best]) {
+            chunk.best = row;
+        }
+    }
+    for (auto &update : scratch.local_updates) {
+        chunk.local_updates[colony.row_parts[update.second.row]].push_back(update.second);
+    }
+    if (parameters_.system == AntSystem::kAntSystem) {
+        for (int ant = first_ant; ant < first_ant + end; ant++) {
+            ScatterDeposits(colony, chunk, ant);
+        }
+        if (chunk.improved) {
+            ScatterDeposits(colony, chunk, parameters_.ants + first_ant / kAntsInChunk);
         }
     }
-    double nominator = pheromones_(rows, cols) * (1.0 / matrix_(rows, cols));
-    return (nominator / denominator);
 }
 
-int AntAlgorithm::GetNextNode(int cur_pos, std::set<int> &nodes, S21Matrix &event_) {
-    if (nodes.size() == 1) {
-        return *(nodes.begin());
+double AntAlgorithm::ImproveTour(LocalSearch &local_search, std::vector<int> &tour, Chunk &chunk) {
+    auto start = std::chrono::steady_clock::now();
+    double length = local_search.Improve(tour) - home_distances_[tour.back()];
+    std::chrono::duration<double> duration = std::chrono::steady_clock::now() - start;
+    chunk.local_search_time += duration.count();
+    return length;
+}
+
+int AntAlgorithm::EvaluateTours(Colony &colony, int first_row, int end_row) const {
+    // Ways back home are added in one pass over the rows, then the first shortest tour wins
+    const size_t last = count_of_nodes_ - 1;
+    const int *tours = colony.tours.data();
+    for (int row = first_row; row < end_row; ++row) {
+        colony.tour_lengths[row] =
+            colony.path_lengths[row] + home_distances_[tours[row * (last + 1) + last]];
+    }
+    int best = first_row;
+    for (int row = first_row + 1; row < end_row; ++row) {
+        if (colony.tour_lengths[row] < colony.tour_lengths[best]) best = row;
     }
-    std::vector<double> event_vec;
-    double sum = 0.0;
-    for (int j = 0; j < matrix_.get_rows(); ++j) {
-        if (matrix_(cur_pos, j) != 0.0 && nodes.find(j) != nodes.end()) {
-            sum += event_(cur_pos, j);
-            event_vec.push_back(sum);
-        } else {
-            event_vec.push_back(0.0);
+    return best;
+}
+
+double AntAlgorithm::BuildAntPath(Colony &colony, AntScratch &scratch, std::uint64_t ant_seed) {
+    scratch.Reset();
+    scratch.random.Seed(ant_seed);
+    double ants_path = 0.0;
+    int current_pos = 0;
+    scratch.Visit(current_pos);
+    while (!scratch.unvisited.empty()) {
+        int old_pos = current_pos;
+        current_pos = GetNextNode(colony, current_pos, scratch);
+        scratch.Visit(current_pos);
+        ants_path += scratch.slot != -1 ? graph_->CandidateDistance(old_pos, scratch.slot, current_pos)
+                                        : graph_->Distance(old_pos, current_pos);
+        if (parameters_.system == AntSystem::kColonySystem) {
+            std::int64_t index = colony.pheromones.Index(old_pos, current_pos);
+            if (index != -1) {
+                LocalUpdate &update = scratch.local_updates[index];
+                update.index = index;
+                update.row = colony.pheromones.Row(old_pos, current_pos);
+                update.count++;
+            }
         }
     }
-    int ind = -1;
-    double random_value = (double)rand() / (RAND_MAX);
-    for (size_t j = 0; j < event_vec.size(); ++j) {
-        if (event_vec[j] != 0.0 &&
-            (event_vec[j] > random_value && (ind == -1 || random_value > LastPositiveEvent(event_vec, j)))) {
-            ind = j;
+    return ants_path;
+}
+
+int AntAlgorithm::GetNextNode(Colony &colony, int cur_pos, AntScratch &scratch) {
+    std::vector<int> &nodes = scratch.unvisited;
+    scratch.slot = -1;
+    if (nodes.size() == 1) {
+        return nodes[0];
+    }
+    const EdgeMatrix &choice_info = colony.choice_info;
+    // ACS takes the best edge with probability q0 and makes the roulette otherwise
+    bool exploit = parameters_.system == AntSystem::kColonySystem &&
+                   scratch.random.NextDouble() < parameters_.exploitation;
+    scratch.choices_count = 0;
+    if (candidates_count_ > 0) {
+        const int *candidates = &candidates_[(size_t)cur_pos * candidates_count_];
+        for (int k = 0; k < candidates_count_; ++k) {
+            if (scratch.position[candidates[k]] != -1) {
+                std::int64_t index = choice_info.CandidateIndex(cur_pos, k, candidates[k]);
+                double weight = GetWeight(colony, index, cur_pos, candidates[k], scratch);
+                scratch.AddChoice(candidates[k], weight, k);
+            }
+        }
+        if (scratch.choices_count > 0) {
+            return SelectNode(exploit, scratch);
         }
     }
-    return ind;
+    // All candidates are visited: the choice is made from all unvisited nodes.
+    // Edges to other nodes are not stored in kCandidates and take the background pheromone
+    for (size_t k = 0; k < nodes.size(); ++k) {
+        std::int64_t index = choice_info.stores_all_edges() ? choice_info.Index(cur_pos, nodes[k]) : -1;
+        scratch.AddChoice(nodes[k], GetWeight(colony, index, cur_pos, nodes[k], scratch));
+    }
+    if (scratch.choices_count == 0) {
+        return nodes[0];
+    }
+    return SelectNode(exploit, scratch);
 }
 
-double AntAlgorithm::LastPositiveEvent(std::vector<double> &event_vec, int j) {
-    --j;
-    while (j >= 0 && event_vec[j] == 0.0) {
-        --j;
+double AntAlgorithm::GetWeight(const Colony &colony, std::int64_t index, int from, int to,
+                               const AntScratch &scratch) const {
+    if (index == -1) {
+        return GetChoiceInfo(colony.pheromones.background, GetHeuristic(from, to));
+    }
+    if (!scratch.local_updates.empty()) {
+        auto update = scratch.local_updates.find(index);
+        if (update != scratch.local_updates.end()) {
+            double kept = std::pow(1.0 - parameters_.local_evaporation, update->second.count);
+            double pheromone = tau0_ + (colony.pheromones[index] - tau0_) * kept;
+            return GetChoiceInfo(pheromone, heuristic_[index]);
+        }
     }
-    return event_vec[j];
+    return colony.choice_info[index];
 }
 
-void AntAlgorithm::IncreaseDelta(int path_of_cur, std::vector<int> &visited) {
-    int last_ind = visited[0];
-    const double Q = 10.0;
-    mt.lock();
-    for (size_t i = 1; i < visited.size(); ++i) {
-        pheromones_delta_(last_ind, visited[i]) += Q / path_of_cur;
-        last_ind = visited[i];
+int AntAlgorithm::SelectNode(bool exploit, AntScratch &scratch) const {
+    int count = scratch.choices_count;
+    const double *weights = scratch.weights.data();
+    int best = 0;
+    if (exploit) {
+        for (int k = 1; k < count; ++k) {
+            if (weights[k] > weights[best]) best = k;
+        }
+    } else if (parameters_.selection == SelectionRule::kTournament) {
+        best = SpinTournament(weights, count, parameters_.tournament_size, scratch.random);
+    } else if (parameters_.float_weights) {
+        best = SpinRoulette(weights, count, scratch.prefix_float.data(), scratch.random.NextDouble());
+    } else {
+        best = SpinRoulette(weights, count, scratch.prefix.data(), scratch.random.NextDouble());
     }
-    mt.unlock();
+    scratch.slot = scratch.slots[best];
+    return scratch.choices[best];
 }
 
-TsmResult AntAlgorithm::GetFullPath(std::vector<int> &visited) {
-    double cur_path = 0.0;
+void AntAlgorithm::AllocateTours(Colony &colony) const {
+    int rows = parameters_.ants + colony.chunks.size();
+    colony.tours.assign((size_t)rows * count_of_nodes_, 0);
+    colony.path_lengths.assign(rows, 0.0);
+    colony.tour_lengths.assign(rows, 0.0);
+}
 
-    S21Matrix available(pheromones_);
-    int cur_pos = 0;
-    for (size_t i = 1; i < visited.size(); ++i) {
-        cur_path += matrix_(cur_pos, visited[i]);
-        cur_pos = visited[i];
+TsmResult AntAlgorithm::GetFullPath(const Colony &colony, int row) const {
+    auto tour = colony.tours.begin() + (size_t)row * count_of_nodes_;
+    std::vector<int> vertices(tour, tour + count_of_nodes_);
+    // Way from the last visited node to home is taken from the predecessors of home, then reversed.
+    // In a metric graph it is the direct edge.
+    int last = vertices.back();
+    size_t tail = vertices.size();
+    if (predecessors_.empty()) {
+        if (last != 0) vertices.push_back(0);
+    } else {
+        for (int i = 0; i != last; i = predecessors_[(size_t)last * count_of_nodes_ + i]) {
+            vertices.push_back(i);
+        }
+        std::reverse(vertices.begin() + tail, vertices.end());
     }
-    // Reversed path from last visited node to home
-    TsmResult reversed = GetShortestPath(visited.back() + 1, 1);
-    for (int i = reversed.vertices.size() - 2; i >= 0; --i) {
-        visited.push_back(reversed.vertices[i]);
+    return TsmResult(vertices, colony.tour_lengths[row]);
+}
+
+bool AntAlgorithm::IsTriangleInequalityHeld() const {
+    std::atomic<bool> held(true);
+    int threads = std::max(1, std::min(parameters_.threads, count_of_nodes_));
+    Executor::Instance().ParallelRun(threads, [&](int id) {
+        for (int from = id; from < count_of_nodes_ && held; from += threads) {
+            for (int via = 0; via < count_of_nodes_; ++via) {
+                double first = graph_->Distance(from, via);
+                for (int to = 0; to < count_of_nodes_; ++to) {
+                    if (graph_->Distance(from, to) > first + graph_->Distance(via, to)) {
+                        held = false;
+                        return;
+                    }
+                }
+            }
+        }
+    });
+    return held;
+}
+
+void AntAlgorithm::CalculateAllShortestPaths() {
+    home_distances_.resize(count_of_nodes_);
+    // Explicit instances are often metric too: one check without extra memory saves the paths
+    int limit = parameters_.shortest_paths_max_nodes;
+    if (graph_->is_metric() || (limit > 0 && count_of_nodes_ > limit) || IsTriangleInequalityHeld()) {
+        predecessors_.clear();
+        for (int i = 0; i < count_of_nodes_; ++i) {
+            home_distances_[i] = graph_->Distance(i, 0);
+        }
+        return;
     }
-    cur_path += reversed.distance;
-    return TsmResult(visited, cur_path);
+    predecessors_.assign((size_t)count_of_nodes_ * count_of_nodes_, -1);
+    // Graph does not change during a solve, so Dijkstra runs once per source, sources split between threads
+    int threads = std::max(1, std::min(parameters_.threads, count_of_nodes_));
+    Executor::Instance().ParallelRun(threads, [&](int id) {
+        std::vector<double> pos(count_of_nodes_);
+        std::vector<char> done(count_of_nodes_);
+        for (int source = id; source < count_of_nodes_; source += threads) {
+            CalculateShortestPaths(source, pos, done);
+            home_distances_[source] = pos[0];
+        }
+    });
 }
 
-TsmResult AntAlgorithm::GetShortestPath(int vertex1, int vertex2) {
-    int size = matrix_.get_rows();
-    std::vector<int> pos(size), node(size), parent(size);
-    int big_number = std::numeric_limits<int>::max();
-    for (int i = 0; i < size; ++i) {
-        pos[i] = big_number;
-        node[i] = 0;
-        parent[i] = -1;
+void AntAlgorithm::CalculateCandidates() {
+    // Lists as long as the graph itself give nothing over the scan of all unvisited nodes
+    candidates_count_ = parameters_.candidates < count_of_nodes_ - 1 ? parameters_.candidates : 0;
+    candidates_.assign((size_t)count_of_nodes_ * candidates_count_, 0);
+    graph_->CacheEdges({}, 0);
+    if (candidates_count_ == 0) {
+        return;
     }
-    int min = 0, index_min = 0;
-    pos[vertex1 - 1] = 0;
+    int threads = std::max(1, std::min(parameters_.threads, count_of_nodes_));
+    Executor::Instance().ParallelRun(threads, [&](int id) {
+        std::vector<int> nodes(count_of_nodes_ - 1);
+        std::vector<double> row(count_of_nodes_);
+        for (int i = id * count_of_nodes_ / threads; i < (id + 1) * count_of_nodes_ / threads; ++i) {
+            for (int j = 0, k = 0; j < count_of_nodes_; ++j) {
+                row[j] = graph_->Distance(i, j);
+                if (j != i) nodes[k++] = j;
+            }
+            auto closer = [&](int a, int b) { return row[a] < row[b] || (row[a] == row[b] && a < b); };
+            std::partial_sort(nodes.begin(), nodes.begin() + candidates_count_, nodes.end(), closer);
+            std::copy(nodes.begin(), nodes.begin() + candidates_count_,
+                      candidates_.begin() + (size_t)i * candidates_count_);
+        }
+    });
+    if (parameters_.cache_candidate_edges) {
+        graph_->CacheEdges(candidates_, candidates_count_);
+    }
+}
+
+void AntAlgorithm::CalculateShortestPaths(int source, std::vector<double> &pos, std::vector<char> &done) {
+    int size = count_of_nodes_;
+    int *parent = &predecessors_[(size_t)source * size];
+    const double big_number = std::numeric_limits<double>::infinity();
+    std::fill(done.begin(), done.end(), 0);
+    std::fill(pos.begin(), pos.end(), big_number);
+    pos[source] = 0.0;
     for (int i = 0; i < size; ++i) {
-        min = big_number;
+        double min = big_number;
+        int index_min = -1;
         for (int j = 0; j < size; ++j) {
-            if (!node[j] && pos[j] < min) {
+            if (!done[j] && pos[j] < min) {
                 min = pos[j];
                 index_min = j;
             }
         }
-        node[index_min] = 1;
+        if (index_min == -1) break;
+        done[index_min] = 1;
         for (int j = 0; j < size; ++j) {
-            if (!node[j] && matrix_(index_min, j) && pos[index_min] != big_number &&
-                pos[index_min] + matrix_(index_min, j) < pos[j]) {
-                pos[j] = pos[index_min] + matrix_(index_min, j);
+            double distance = graph_->Distance(index_min, j);
+            if (!done[j] && distance != 0.0 && min + distance < pos[j]) {
+                pos[j] = min + distance;
                 parent[j] = index_min;
             }
         }
     }
-
-    std::vector<int> temp;
-    for (int i = vertex2 - 1; i != -1; i = parent[i]) {
-        temp.push_back(i);
-    }
-    return TsmResult(temp, pos[vertex2 - 1]);
 }
 }  // namespace s21
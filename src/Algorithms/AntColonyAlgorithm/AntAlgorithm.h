@@ -1,12 +1,28 @@
 #ifndef PARALLELS_ANTCOLONYALGORITHM_H
 #define PARALLELS_ANTCOLONYALGORITHM_H
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <istream>
+#include <limits>
+#include <memory>
 #include <mutex>
-#include <set>
+#include <ostream>
 #include <thread>
+#include <unordered_map>
 #include <vector>
 
+#include "../../DataStructures/DistanceProvider/DistanceProvider.h"
+#include "../../DataStructures/EdgeMatrix/EdgeMatrix.h"
 #include "../../DataStructures/Matrix/Matrix.h"
+#include "../../Utils/Executor/Executor.h"
+#include "../../Utils/Random/Xoshiro256.h"
+#include "LocalSearch.h"
+#include "Selection.h"
 
 namespace s21 {
 
@@ -21,31 +37,243 @@ struct TsmResult {
     }
 };
 
+// Ant System: every ant deposits. MAX-MIN Ant System: only the best tour deposits and pheromones
+// stay in bounds. Ant Colony System: pseudo-random proportional rule and local pheromone update.
+enum class AntSystem { kAntSystem, kMaxMin, kColonySystem };
+
+// Roulette chooses the next node with the probability proportional to its weight. Tournament takes
+// the heaviest of a few nodes drawn uniformly
+enum class SelectionRule { kRoulette, kTournament };
+
+// Islands send their best tours or blend pheromones with the previous island or with all islands
+enum class MigrationTopology { kRing, kAllToAll };
+enum class MigrationMode { kBestTour, kPheromoneBlend };
+
+// Reason the last solve stopped, kRunning while it runs
+enum class StopReason { kRunning, kIterations, kTimeBudget, kTargetLength, kStagnation, kCancelled };
+
+// State of a solve after an iteration. Tours are numbered from 1 like in GetResult
+struct AntProgress {
+    TsmResult best = TsmResult({}, -1.0);
+    int iteration = 0;            // iterations done
+    int stagnation = 0;           // iterations since the best tour improved
+    double iteration_best = 0.0;  // length of the best tour of the last iteration
+    double iteration_mean = 0.0;  // mean length of the tours of the last iteration
+    double elapsed = 0.0;         // seconds since the start of the solve
+    StopReason stop_reason = StopReason::kRunning;
+};
+
+struct AntParameters {
+    int threads = std::max(1, (int)std::thread::hardware_concurrency());  // workers of SolveUsingParallelism
+    int ants = 1200;             // ants per iteration
+    double alpha = 1.0;          // weight of pheromone in the choice of the next node
+    double beta = 1.0;           // weight of 1 / distance in the choice of the next node
+    double evaporation = 0.5;    // share of pheromone evaporated after every iteration
+    double Q = 10.0;             // pheromone deposited by an ant is Q / length of its path
+    double initial_pheromone = 0.2;
+    int candidates = 20;         // nearest neighbours an ant chooses from first, 0 to consider all nodes
+    LocalSearchMode local_search = LocalSearchMode::kNone;  // tours improved by 2-opt and Or-opt
+    SelectionRule selection = SelectionRule::kRoulette;
+    int tournament_size = 3;
+    bool float_weights = false;  // prefix sums of the roulette in float, twice as many fit a cache line
+    AntSystem system = AntSystem::kAntSystem;
+    bool deposit_best_so_far = false;  // MMAS: best tour of the solve deposits instead of iteration best
+    int stagnation_iterations = 50;    // MMAS: iterations without improvement before pheromones are reset
+    double exploitation = 0.9;         // ACS: probability to take the best edge instead of the roulette
+    double local_evaporation = 0.1;    // ACS: share of pheromone an ant removes from the edge it passes
+    int islands = 1;                   // independent colonies with their own pheromones, run in parallel
+    int migration_interval = 10;       // iterations of islands between migrations
+    MigrationTopology topology = MigrationTopology::kRing;
+    MigrationMode migration = MigrationMode::kBestTour;
+    double migration_blend = 0.1;      // share of pheromone taken from other islands in kPheromoneBlend
+    bool cache_candidate_edges = false;  // distance provider keeps distances of candidate edges
+    // Graphs that are not metric and have more nodes use direct edges instead of the shortest paths
+    // between all nodes, which take n^3 time and n^2 memory. 0 removes the limit. Read by SetData
+    int shortest_paths_max_nodes = 2000;
+    EdgeStorage pheromone_storage = EdgeStorage::kDense;  // layout of pheromones and heuristic values
+    // Solve stops after N iterations or earlier by any of the criteria, 0 turns a criterion off
+    double time_budget = 0.0;        // seconds of wall-clock time
+    double target_length = 0.0;      // length of a tour that is good enough
+    int stagnation_limit = 0;        // iterations without improvement of the best tour
+    bool warm_start = false;  // solve continues from the pheromones of the previous solve or LoadState
+    std::uint64_t seed = 21;
+};
+
 class AntAlgorithm {
 public:
-    void SetData(S21Matrix &matrix, int N);
+    // Zero elements of the matrix are treated as missing edges, the matrix itself is not changed
+    void SetData(const S21Matrix &matrix, int N);
+    // Graph given by a provider is complete, distances are asked on demand
+    void SetData(std::shared_ptr<DistanceProvider> graph, int N);
+    void SetIterations(int N);
+    // Nodes are numbered from 0 like rows of the matrix, both directions change for symmetric storage.
+    // Heuristic values change at once, shortest paths and candidate lists before the next solve
+    void UpdateEdge(int from, int to, double distance);
+    void SetParameters(const AntParameters &parameters);
+    const AntParameters &GetParameters() const;
+    // Same seed gives the same tours regardless of the number of threads
+    void SetSeed(std::uint64_t seed);
     void SolveWithoutUsingParallelism();
     void SolveUsingParallelism();
+    void SolveUsingThreads(int threads);
     TsmResult &GetResult();
+    // Called by the solving thread after every iteration, in the island mode after every migration
+    void SetProgressCallback(std::function<void(const AntProgress &)> callback);
+    // Safe to call from any thread while a solve runs
+    AntProgress GetProgress() const;
+    // Stops the running solve after the current iteration, can be called from any thread
+    void Cancel();
+    // Time spent in the local search by all threads during the last solve
+    double GetLocalSearchTime() const;
+    // Pheromones and the best tour of an island after the last solve, nodes of the tour numbered from 1
+    const EdgeMatrix &GetPheromones(int island = 0) const;
+    TsmResult GetIslandBest(int island) const;
+    // Binary checkpoint of the pheromones and the best tours of all colonies. LoadState fails for
+    // a checkpoint of another graph size, storage, candidate lists or count of islands
+    void SaveState(std::ostream &out) const;
+    bool LoadState(std::istream &in);
 
 private:
-    S21Matrix pheromones_, pheromones_delta_, matrix_;
-    std::mutex mt;
-    double count_of_nodes_, max_length_;
+    struct LocalUpdate {
+        std::int64_t index;
+        int row, count;
+    };
+    struct Deposit {
+        std::int64_t index;
+        double amount;
+    };
+
+    // Buffers of one ant reused for all its tours, so building a tour does not allocate
+    struct AntScratch {
+        std::vector<int> visited;
+        std::vector<int> unvisited;  // dense list of nodes not visited yet
+        std::vector<int> position;   // index of the node in unvisited or -1
+        // Nodes with positive weight the next node is chosen from, count of them and prefix sums of weights
+        std::vector<int> choices;
+        std::vector<double> weights;
+        int choices_count = 0;
+        // Position of a choice in the candidate list of the node or -1, and the one of the chosen node
+        std::vector<int> slots;
+        int slot = -1;
+        std::vector<double> prefix;
+        std::vector<float> prefix_float;
+        Xoshiro256 random;
+        // ACS: passes through stored edges by the ants of the current chunk, applied on top of pheromones,
+        // keyed by the index of the edge
+        std::unordered_map<std::int64_t, LocalUpdate> local_updates;
+
+        explicit AntScratch(int count_of_nodes);
+        void Reset();
+        void Visit(int node);
+        void AddChoice(int node, double weight, int candidate_slot = -1) {
+            if (weight > 0.0) {
+                slots[choices_count] = candidate_slot;
+                choices[choices_count] = node;
+                weights[choices_count++] = weight;
+            }
+        }
+    };
+
+    // Ants of an iteration are split into chunks of fixed size, which workers take dynamically.
+    // A chunk keeps everything its ants write, so workers share no mutable state and the
+    // reduction in chunk order does not depend on the number of threads.
+    // Deposits and passes of the chunk are bucketed by the part of rows that owns the edge, so the
+    // worker reducing a part reads only its own buckets.
+    struct Chunk {
+        std::vector<std::vector<Deposit>> deposits;
+        std::vector<std::vector<LocalUpdate>> local_updates;
+        int best = 0;           // row of the shortest tour of the chunk in the tour buffer
+        bool improved = false;  // local search row of the chunk holds a tour
+        double local_search_time = 0.0;
+    };
+    static constexpr int kAntsInChunk = 16;
+
+    // Pheromones and the best tours of one colony. In the island mode every island owns a colony
+    // and the colonies meet only at migrations.
+    struct Colony {
+        // choice_info holds pheromone^alpha * heuristic_ in the same layout as pheromones
+        EdgeMatrix pheromones, choice_info;
+        std::vector<Chunk> chunks;
+        // Tours of the current iteration, allocated once. Row a holds the nodes of ant a in the order of
+        // visits, row ants + c holds the tour improved by the local search of chunk c
+        std::vector<int> tours;
+        std::vector<double> path_lengths;  // lengths without the way back home
+        std::vector<double> tour_lengths;
+        TsmResult best = TsmResult({}, -1.0), deposit_tour;
+        double iteration_best = 0.0, iteration_mean = 0.0;
+        double tau_min = 0.0, tau_max = 0.0;
+        int stagnation = 0;
+        bool reset_pheromones = false;
+        std::uint64_t seed = 0;
+        // Rows of pheromones are split into parts reduced in parallel, row_parts holds the part of a row
+        std::vector<int> row_parts;
+        int parts = 1;
+    };
+
+    std::shared_ptr<DistanceProvider> graph_;
+    // heuristic_ holds (1 / distance)^beta of the stored edges
+    EdgeMatrix heuristic_;
+    // Shortest paths between all nodes, computed in SetData for graphs that are not metric. Row i of
+    // predecessors_ holds the previous node on the shortest way from i to every node
+    std::vector<int> predecessors_;
+    std::vector<double> home_distances_;  // length of the shortest way from every node to node 0
+    // Row i holds the candidates_count_ nearest neighbours of node i sorted by distance
+    std::vector<int> candidates_;
+    int candidates_count_ = 0;
+    AntParameters parameters_;
+    int count_of_nodes_ = 0;
+    double max_length_;
     TsmResult shortest_path_;
+    double local_search_time_ = 0.0;
+    std::vector<Colony> colonies_;
+    double tau0_ = 0.0;
     int N;
+    std::function<void(const AntProgress &)> progress_callback_;
+    AntProgress progress_;
+    mutable std::mutex progress_mutex_;
+    std::atomic<bool> stop_{false};
+    std::chrono::steady_clock::time_point start_;
+    bool graph_changed_ = false;
 
-    void FillEmptyNodes();
-    void MainIteration(bool multithreading);
-    void BuildPath(int end);
-    void ApplyDeltaToPheromones();
-    double GetEventPossibility(int rows, int cols, std::set<int> &nodes);
-    int GetNextNode(int cur_pos, std::set<int> &nodes, S21Matrix &event_);
-    double LastPositiveEvent(std::vector<double> &event_vec, int j);
-    void IncreaseDelta(int path_of_cur, std::vector<int> &visited);
-    TsmResult GetFullPath(std::vector<int> &visited);
-    TsmResult GetShortestPath(int vertex1, int vertex2);
-    void AntColonyAlgorithm(int end);
+    static void FillEmptyNodes(S21Matrix &matrix);
+    void CheckStorage(const AntParameters &parameters) const;
+    void CalculateHeuristic();
+    double GetHeuristic(int from, int to) const;
+    void CalculateChoiceInfo(Colony &colony, int start_row, int end_row);
+    double GetChoiceInfo(double pheromone, double heuristic) const;
+    void MainIteration(int threads);
+    void InitColony(Colony &colony, double initial_pheromone, std::uint64_t seed);
+    void InitColonies(double initial_pheromone);
+    bool CanResume() const;
+    void ResumeColony(Colony &colony);
+    double GetTourLength(const std::vector<int> &tour) const;
+    double GetInitialPheromone();
+    double GetNearestNeighbourLength() const;
+    void Migrate();
+    void AddPheromone(Colony &colony, const TsmResult &tour, double amount);
+    void UpdateBestTours(Colony &colony);
+    double GetWeight(const Colony &colony, std::int64_t index, int from, int to,
+                     const AntScratch &scratch) const;
+    int SelectNode(bool exploit, AntScratch &scratch) const;
+    int AntColonyAlgorithm(Colony &colony, int threads, int first_iteration, int end_iteration, bool report);
+    void UpdateProgress(int iteration);
+    void Stop(StopReason reason);
+    double GetElapsed() const;
+    void BuildPath(Colony &colony, AntScratch &scratch, LocalSearch &local_search, Chunk &chunk,
+                   int first_ant, int end, int iteration);
+    double ImproveTour(LocalSearch &local_search, std::vector<int> &tour, Chunk &chunk);
+    int EvaluateTours(Colony &colony, int first_row, int end_row) const;
+    double BuildAntPath(Colony &colony, AntScratch &scratch, std::uint64_t ant_seed);
+    void SplitRows(Colony &colony, int parts) const;
+    void ScatterDeposits(Colony &colony, Chunk &chunk, int row) const;
+    void ApplyDeltaToPheromones(Colony &colony, int part);
+    int GetNextNode(Colony &colony, int cur_pos, AntScratch &scratch);
+    void AllocateTours(Colony &colony) const;
+    TsmResult GetFullPath(const Colony &colony, int row) const;
+    bool IsTriangleInequalityHeld() const;
+    void CalculateAllShortestPaths();
+    void CalculateCandidates();
+    void CalculateShortestPaths(int source, std::vector<double> &pos, std::vector<char> &done);
 };
 }  // namespace s21
 
@@ -0,0 +1,129 @@
+#include "LocalSearch.h"
+
+#include <algorithm>
+
+namespace s21 {
+namespace {
+const double kEpsilon = 1e-9;
+const int kMaxSegment = 3;
+}  // namespace
+
+LocalSearch::LocalSearch(const DistanceProvider &graph, const std::vector<double> &home_distances,
+                         const std::vector<int> &candidates, int candidates_count)
+    : graph_(graph),
+      home_distances_(home_distances),
+      candidates_(candidates),
+      candidates_count_(candidates_count) {}
+
+double LocalSearch::Improve(std::vector<int> &tour) {
+    size_ = tour.size();
+    position_.resize(size_);
+    forward_.resize(size_);
+    backward_.resize(size_);
+    is_active_.assign(size_, 0);
+    active_.clear();
+    forward_[0] = backward_[0] = 0.0;
+    Update(tour, 0, size_ - 1);
+    if (size_ >= 4) {
+        for (int i = size_ - 1; i >= 0; --i) {
+            Activate(tour[i]);
+        }
+        while (!active_.empty()) {
+            int node = active_.back();
+            active_.pop_back();
+            is_active_[node] = 0;
+            if (TwoOpt(tour, node) || OrOpt(tour, node)) {
+                Activate(node);
+            }
+        }
+    }
+    return forward_[size_ - 1] + Cost(tour[size_ - 1], 0);
+}
+
+double LocalSearch::Cost(int from, int to) const {
+    return to == 0 ? home_distances_[from] : graph_.Distance(from, to);
+}
+
+int LocalSearch::Next(const std::vector<int> &tour, int pos) const {
+    return pos + 1 < size_ ? tour[pos + 1] : tour[0];
+}
+
+void LocalSearch::Activate(int node) {
+    if (!is_active_[node]) {
+        is_active_[node] = 1;
+        active_.push_back(node);
+    }
+}
+
+void LocalSearch::Update(const std::vector<int> &tour, int from, int to) {
+    for (int p = from; p <= to; ++p) {
+        position_[tour[p]] = p;
+    }
+    for (int p = std::max(from, 1); p < size_; ++p) {
+        forward_[p] = forward_[p - 1] + Cost(tour[p - 1], tour[p]);
+        backward_[p] = backward_[p - 1] + Cost(tour[p], tour[p - 1]);
+    }
+}
+
+template <class Function>
+bool LocalSearch::ForEachNeighbour(int node, Function function) const {
+    if (candidates_count_ > 0) {
+        const int *candidates = &candidates_[(size_t)node * candidates_count_];
+        for (int k = 0; k < candidates_count_; ++k) {
+            if (function(candidates[k])) return true;
+        }
+    } else {
+        for (int other = 0; other < size_; ++other) {
+            if (other != node && function(other)) return true;
+        }
+    }
+    return false;
+}
+
+// Reversal of the segment i..j replaces edges (i - 1, i) and (j, j + 1) with (i - 1, j) and (i, j + 1).
+// A neighbour of the node before or after the segment gives the new edge.
+bool LocalSearch::TwoOpt(std::vector<int> &tour, int node) {
+    int p = position_[node];
+    return ForEachNeighbour(node, [&](int neighbour) {
+        int q = position_[neighbour];
+        int i = std::min(p, q) + 1, j = std::max(p, q);
+        if (j - i < 1) return false;
+        int a = tour[i - 1], b = tour[i], c = tour[j], d = Next(tour, j);
+        double delta = Cost(a, c) + Cost(b, d) - Cost(a, b) - Cost(c, d) + (backward_[j] - backward_[i]) -
+                       (forward_[j] - forward_[i]);
+        if (delta > -kEpsilon) return false;
+        std::reverse(tour.begin() + i, tour.begin() + j + 1);
+        Update(tour, i, j);
+        Activate(a), Activate(b), Activate(c), Activate(d);
+        return true;
+    });
+}
+
+// Moves the segment of up to three nodes starting at node right after one of its neighbours
+bool LocalSearch::OrOpt(std::vector<int> &tour, int node) {
+    int i = position_[node];
+    for (int length = 1; length <= kMaxSegment && i > 0 && i + length <= size_; ++length) {
+        int last = i + length - 1;
+        int prev = tour[i - 1], tail = tour[last], next = Next(tour, last);
+        double removed = Cost(prev, node) + Cost(tail, next) - Cost(prev, next);
+        bool moved = ForEachNeighbour(node, [&](int neighbour) {
+            int q = position_[neighbour];
+            if (q >= i - 1 && q <= last) return false;
+            int after = Next(tour, q);
+            double delta = Cost(neighbour, node) + Cost(tail, after) - Cost(neighbour, after) - removed;
+            if (delta > -kEpsilon) return false;
+            if (q > last) {
+                std::rotate(tour.begin() + i, tour.begin() + last + 1, tour.begin() + q + 1);
+                Update(tour, i, q);
+            } else {
+                std::rotate(tour.begin() + q + 1, tour.begin() + i, tour.begin() + last + 1);
+                Update(tour, q + 1, last);
+            }
+            Activate(prev), Activate(next), Activate(neighbour), Activate(after), Activate(tail);
+            return true;
+        });
+        if (moved) return true;
+    }
+    return false;
+}
+}  // namespace s21
@@ -0,0 +1,47 @@
+#ifndef PARALLELS_LOCALSEARCH_H
+#define PARALLELS_LOCALSEARCH_H
+
+#include <vector>
+
+#include "../../DataStructures/DistanceProvider/DistanceProvider.h"
+
+namespace s21 {
+
+enum class LocalSearchMode { kNone, kIterationBest, kAllTours };
+
+// 2-opt and Or-opt over a tour that starts at node 0. Costs may be asymmetric: the cost of a reversed
+// segment is taken from prefix sums of the tour in both directions. The way back to node 0 costs
+// home_distances of the last node, the other edges cost the edge of the graph.
+class LocalSearch {
+public:
+    LocalSearch(const DistanceProvider &graph, const std::vector<double> &home_distances,
+                const std::vector<int> &candidates, int candidates_count);
+    // Returns the length of the improved tour together with the way back home
+    double Improve(std::vector<int> &tour);
+
+private:
+    const DistanceProvider &graph_;
+    const std::vector<double> &home_distances_;
+    const std::vector<int> &candidates_;
+    int candidates_count_;
+    int size_ = 0;
+    std::vector<int> position_;
+    // forward_[p] is the length of the tour up to position p, backward_[p] is the same length when
+    // every edge is passed in the opposite direction
+    std::vector<double> forward_, backward_;
+    // Nodes with the don't-look bit cleared
+    std::vector<int> active_;
+    std::vector<char> is_active_;
+
+    double Cost(int from, int to) const;
+    int Next(const std::vector<int> &tour, int pos) const;
+    void Activate(int node);
+    void Update(const std::vector<int> &tour, int from, int to);
+    bool TwoOpt(std::vector<int> &tour, int node);
+    bool OrOpt(std::vector<int> &tour, int node);
+    template <class Function>
+    bool ForEachNeighbour(int node, Function function) const;
+};
+}  // namespace s21
+
+#endif  // PARALLELS_LOCALSEARCH_H
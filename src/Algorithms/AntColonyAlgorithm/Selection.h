@@ -0,0 +1,41 @@
+#ifndef PARALLELS_SELECTION_H
+#define PARALLELS_SELECTION_H
+
+#include "../../Utils/Random/Xoshiro256.h"
+
+namespace s21 {
+
+// Index of the chosen weight for a random value in [0, 1): prefix sums are built in a tight loop and
+// the first sum above the threshold is found by a binary search without branches. A threshold rounded
+// up to the total falls to the last positive weight, so zero weights are never chosen.
+template <class T>
+int SpinRoulette(const double *weights, int count, T *prefix, double random) {
+    T sum = 0;
+    for (int k = 0; k < count; ++k) {
+        sum += (T)weights[k];
+        prefix[k] = sum;
+    }
+    T threshold = (T)(random * sum);
+    const T *base = prefix;
+    for (int n = count; n > 1; n -= n / 2) {
+        base = base[n / 2] <= threshold ? base + n / 2 : base;
+    }
+    int index = (base - prefix) + (*base <= threshold);
+    if (index == count) {
+        for (index = count - 1; index > 0 && weights[index] <= 0.0;) --index;
+    }
+    return index;
+}
+
+// Index of the heaviest of size weights drawn uniformly, the first drawn wins a tie
+inline int SpinTournament(const double *weights, int count, int size, Xoshiro256 &random) {
+    int best = random.NextBelow(count);
+    for (int round = 1; round < size; ++round) {
+        int k = random.NextBelow(count);
+        if (weights[k] > weights[best]) best = k;
+    }
+    return best;
+}
+}  // namespace s21
+
+#endif  // PARALLELS_SELECTION_H
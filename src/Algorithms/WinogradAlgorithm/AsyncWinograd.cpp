@@ -0,0 +1,130 @@
+#include "AsyncWinograd.h"
+
+namespace s21 {
+
+MultiplyTask::MultiplyTask(Executor *executor) : state_(std::make_shared<State>()) {
+    state_->executor = executor;
+}
+
+S21Matrix MultiplyTask::Get() {
+    Wait();
+    std::lock_guard<std::mutex> lock(state_->mtx);
+    if (state_->status == Status::kCancelled) {
+        throw "Async multiplication error: task was cancelled";
+    } else if (state_->status == Status::kFailed) {
+        std::rethrow_exception(state_->error);
+    }
+    return state_->result;
+}
+
+void MultiplyTask::Wait() {
+    std::unique_lock<std::mutex> lock(state_->mtx);
+    state_->cv.wait(lock, [&] {
+        return state_->status != Status::kPending && state_->status != Status::kRunning;
+    });
+}
+
+bool MultiplyTask::IsReady() const {
+    std::lock_guard<std::mutex> lock(state_->mtx);
+    return state_->status != Status::kPending && state_->status != Status::kRunning;
+}
+
+bool MultiplyTask::Cancel() { return Finish(Status::kCancelled, Status::kPending) || IsCancelled(); }
+
+bool MultiplyTask::IsCancelled() const {
+    std::lock_guard<std::mutex> lock(state_->mtx);
+    return state_->status == Status::kCancelled;
+}
+
+void MultiplyTask::Run(const std::function<S21Matrix()> &job) {
+    {
+        std::lock_guard<std::mutex> lock(state_->mtx);
+        if (state_->status != Status::kPending) return;
+        state_->status = Status::kRunning;
+    }
+    try {
+        S21Matrix result = job();
+        {
+            std::lock_guard<std::mutex> lock(state_->mtx);
+            state_->result = result;
+        }
+        Finish(Status::kDone, Status::kRunning);
+    } catch (...) {
+        Finish(Status::kFailed, Status::kRunning, std::current_exception());
+    }
+}
+
+bool MultiplyTask::Finish(Status status, Status expected, std::exception_ptr error) {
+    std::vector<std::function<void()>> continuations;
+    {
+        std::lock_guard<std::mutex> lock(state_->mtx);
+        if (state_->status != expected) return false;
+        state_->status = status;
+        state_->error = error;
+        continuations.swap(state_->continuations);
+    }
+    state_->cv.notify_all();
+    for (auto &continuation : continuations) continuation();
+    return true;
+}
+
+void MultiplyTask::OnComplete(std::function<void(MultiplyTask)> callback) {
+    MultiplyTask self = *this;
+    std::function<void()> call = [self, callback] { callback(self); };
+    {
+        std::lock_guard<std::mutex> lock(state_->mtx);
+        if (state_->status == Status::kPending || state_->status == Status::kRunning) {
+            state_->continuations.push_back(call);
+            return;
+        }
+    }
+    call();
+}
+
+MultiplyTask MultiplyTask::Then(Continuation continuation) {
+    MultiplyTask child(state_->executor);
+    MultiplyTask parent = *this;
+    OnComplete([child, parent, continuation](MultiplyTask) mutable {
+        std::unique_lock<std::mutex> lock(parent.state_->mtx);
+        Status status = parent.state_->status;
+        std::exception_ptr error = parent.state_->error;
+        lock.unlock();
+        if (status != Status::kDone) {
+            child.Finish(status, Status::kPending, error);
+            return;
+        }
+        child.state_->executor->Submit([child, parent, continuation]() mutable {
+            child.Run([&] {
+                S21Matrix input = parent.state_->result;
+                return continuation(input);
+            });
+        });
+    });
+    return child;
+}
+
+MultiplyTask MultiplyTask::Then(S21Matrix M2, WinogradMode mode, int threads) {
+    return Then([M2, mode, threads](S21Matrix &M1) mutable { return AsyncWinograd::Solve(M1, M2, mode, threads); });
+}
+
+AsyncWinograd::AsyncWinograd(Executor &executor) : executor_(executor) {}
+
+MultiplyTask AsyncWinograd::Submit(S21Matrix M1, S21Matrix M2, WinogradMode mode, int threads) {
+    MultiplyTask task(&executor_);
+    executor_.Submit([task, M1, M2, mode, threads]() mutable {
+        task.Run([&] { return Solve(M1, M2, mode, threads); });
+    });
+    return task;
+}
+
+S21Matrix AsyncWinograd::Solve(S21Matrix &M1, S21Matrix &M2, WinogradMode mode, int threads) {
+    WinogradAlgorithm algorithm;
+    if (mode == WinogradMode::kPipelineParallelism) {
+        return algorithm.SolveWithPipelineParallelism(&M1, &M2);
+    } else if (mode == WinogradMode::kClassicParallelism) {
+        return algorithm.SolveWithClassicParallelism(&M1, &M2, threads);
+    }
+    return algorithm.SolveWithoutParallelism(&M1, &M2);
+}
+
+}  // namespace s21
@@ -0,0 +1,80 @@
+#ifndef PARALLELS_ASYNCWINOGRAD_H
+#define PARALLELS_ASYNCWINOGRAD_H
+
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "../../DataStructures/Matrix/Matrix.h"
+#include "../../Utils/Executor/Executor.h"
+#include "WinogradAlgorithm.h"
+
+namespace s21 {
+
+enum class WinogradMode { kWithoutParallelism, kPipelineParallelism, kClassicParallelism };
+
+// Handle of a multiplication submitted to an executor. Copies of the handle share the same task.
+class MultiplyTask {
+public:
+    using Continuation = std::function<S21Matrix(S21Matrix &)>;
+
+    MultiplyTask() = default;
+
+    // Waits for the task; throws if the task was cancelled or its job threw
+    S21Matrix Get();
+    void Wait();
+    bool IsReady() const;
+
+    // Only a task that has not started yet can be cancelled. Dependent tasks are cancelled too.
+    bool Cancel();
+    bool IsCancelled() const;
+
+    // Runs the continuation on the result of this task when it is ready, without blocking any thread
+    MultiplyTask Then(Continuation continuation);
+    // Multiplies the result of this task by M2
+    MultiplyTask Then(S21Matrix M2, WinogradMode mode = WinogradMode::kWithoutParallelism, int threads = 2);
+    // Callback is called from an executor thread (or from the caller if the task is already finished)
+    void OnComplete(std::function<void(MultiplyTask)> callback);
+
+private:
+    friend class AsyncWinograd;
+
+    enum class Status { kPending, kRunning, kDone, kCancelled, kFailed };
+
+    struct State {
+        Executor *executor;
+        mutable std::mutex mtx;
+        std::condition_variable cv;
+        Status status = Status::kPending;
+        S21Matrix result;
+        std::exception_ptr error;
+        std::vector<std::function<void()>> continuations;
+    };
+
+    std::shared_ptr<State> state_;
+
+    explicit MultiplyTask(Executor *executor);
+    void Run(const std::function<S21Matrix()> &job);
+    bool Finish(Status status, Status expected, std::exception_ptr error = nullptr);
+};
+
+// Submits Winograd multiplications to a shared executor instead of blocking the caller
+class AsyncWinograd {
+public:
+    explicit AsyncWinograd(Executor &executor = Executor::Instance());
+
+    MultiplyTask Submit(S21Matrix M1, S21Matrix M2, WinogradMode mode = WinogradMode::kWithoutParallelism,
+                        int threads = 2);
+
+    static S21Matrix Solve(S21Matrix &M1, S21Matrix &M2, WinogradMode mode, int threads);
+
+private:
+    Executor &executor_;
+};
+
+}  // namespace s21
+
+#endif  // PARALLELS_ASYNCWINOGRAD_H
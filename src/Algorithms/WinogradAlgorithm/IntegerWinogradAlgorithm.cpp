@@ -0,0 +1,204 @@
+#include "IntegerWinogradAlgorithm.h"
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#include <immintrin.h>
+#define INTEGER_WINOGRAD_AVX2
+#endif
+
+namespace s21 {
+
+namespace {
+
+template <typename Acc>
+Acc DotProductScalar(const std::int32_t *ae, const std::int32_t *ao, const std::int32_t *be,
+                     const std::int32_t *bo, int len) {
+    Acc sum = 0;
+    for (int k = 0; k < len; k++) {
+        sum += ((Acc)ae[k] + bo[k]) * ((Acc)ao[k] + be[k]);
+    }
+    return sum;
+}
+
+#ifdef INTEGER_WINOGRAD_AVX2
+__attribute__((target("avx2"))) std::int32_t DotProductAvx2(const std::int32_t *ae, const std::int32_t *ao,
+                                                            const std::int32_t *be, const std::int32_t *bo,
+                                                            int len) {
+    __m256i acc = _mm256_setzero_si256();
+    int k = 0;
+    for (; k + 8 <= len; k += 8) {
+        __m256i x = _mm256_add_epi32(_mm256_loadu_si256((const __m256i *)(ae + k)),
+                                     _mm256_loadu_si256((const __m256i *)(bo + k)));
+        __m256i y = _mm256_add_epi32(_mm256_loadu_si256((const __m256i *)(ao + k)),
+                                     _mm256_loadu_si256((const __m256i *)(be + k)));
+        acc = _mm256_add_epi32(acc, _mm256_mullo_epi32(x, y));
+    }
+    alignas(32) std::int32_t lanes[8];
+    _mm256_store_si256((__m256i *)lanes, acc);
+    std::int32_t sum = 0;
+    for (int i = 0; i < 8; i++) sum += lanes[i];
+    return sum + DotProductScalar<std::int32_t>(ae + k, ao + k, be + k, bo + k, len - k);
+}
+
+// Pair sums have to fit into int32: _mm256_mul_epi32 multiplies low halves of 64-bit lanes
+__attribute__((target("avx2"))) std::int64_t DotProductAvx2Wide(const std::int32_t *ae, const std::int32_t *ao,
+                                                                const std::int32_t *be,
+                                                                const std::int32_t *bo, int len) {
+    __m256i acc = _mm256_setzero_si256();
+    int k = 0;
+    for (; k + 8 <= len; k += 8) {
+        __m256i x = _mm256_add_epi32(_mm256_loadu_si256((const __m256i *)(ae + k)),
+                                     _mm256_loadu_si256((const __m256i *)(bo + k)));
+        __m256i y = _mm256_add_epi32(_mm256_loadu_si256((const __m256i *)(ao + k)),
+                                     _mm256_loadu_si256((const __m256i *)(be + k)));
+        acc = _mm256_add_epi64(acc, _mm256_mul_epi32(x, y));
+        acc = _mm256_add_epi64(acc, _mm256_mul_epi32(_mm256_srli_epi64(x, 32), _mm256_srli_epi64(y, 32)));
+    }
+    alignas(32) std::int64_t lanes[4];
+    _mm256_store_si256((__m256i *)lanes, acc);
+    std::int64_t sum = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+    return sum + DotProductScalar<std::int64_t>(ae + k, ao + k, be + k, bo + k, len - k);
+}
+
+bool CpuSupportsAvx2() {
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported;
+}
+#endif
+
+template <typename Acc>
+Acc DotProduct(const std::int32_t *ae, const std::int32_t *ao, const std::int32_t *be, const std::int32_t *bo,
+               int len, bool pairs_fit_int32) {
+#ifdef INTEGER_WINOGRAD_AVX2
+    if (CpuSupportsAvx2() && pairs_fit_int32) {
+        if (sizeof(Acc) == sizeof(std::int32_t)) {
+            return DotProductAvx2(ae, ao, be, bo, len);
+        }
+        return DotProductAvx2Wide(ae, ao, be, bo, len);
+    }
+#else
+    (void)pairs_fit_int32;
+#endif
+    return DotProductScalar<Acc>(ae, ao, be, bo, len);
+}
+
+std::uint64_t MaxAbsValue(const IntegerMatrix<std::int32_t> &m) {
+    std::uint64_t max = 0;
+    for (int i = 0; i < m.get_rows(); i++) {
+        for (int j = 0; j < m.get_cols(); j++) {
+            std::int64_t value = m(i, j);
+            max = std::max<std::uint64_t>(max, value < 0 ? -value : value);
+        }
+    }
+    return max;
+}
+
+}  // namespace
+
+template <typename Acc>
+bool IntegerWinogradAlgorithm<Acc>::IsOverflowSafe(const IntegerMatrix<std::int32_t> &M1,
+                                                   const IntegerMatrix<std::int32_t> &M2) {
+    unsigned __int128 a = MaxAbsValue(M1), b = MaxAbsValue(M2);
+    unsigned __int128 len = M1.get_cols() / 2;
+    // Every partial sum is bounded by the sum of absolute values of all its terms
+    unsigned __int128 bound = len * (a + b) * (a + b) + len * a * a + len * b * b + a * b;
+    return bound <= (unsigned __int128)std::numeric_limits<Acc>::max();
+}
+
+template <typename Acc>
+IntegerMatrix<Acc> IntegerWinogradAlgorithm<Acc>::Solve(const IntegerMatrix<std::int32_t> &M1,
+                                                        const IntegerMatrix<std::int32_t> &M2, int threads) {
+    if (M1.is_empty() || M2.is_empty()) {
+        printf("Received null matrix\n");
+        return IntegerMatrix<Acc>();
+    } else if (M1.get_cols() != M2.get_rows()) {
+        printf("Wrong matrix dimensions\n");
+        return IntegerMatrix<Acc>();
+    } else if (!IsOverflowSafe(M1, M2)) {
+        printf("Values are too big for the accumulator, overflow is possible\n");
+        return IntegerMatrix<Acc>();
+    }
+
+    Pack(M1, M2);
+    IntegerMatrix<Acc> res(rows_, cols_);
+    int nmb_of_threads = std::max(1, std::min(threads, rows_));
+    Executor::Instance().ParallelFor(0, rows_, 1, nmb_of_threads, [&](int begin, int end) {
+        CalculateResultMatrixValues(res, begin, end);
+    });
+    return res;
+}
+
+template <typename Acc>
+S21Matrix IntegerWinogradAlgorithm<Acc>::Solve(S21Matrix *M1, S21Matrix *M2, int threads) {
+    IntegerMatrix<std::int32_t> left, right;
+    if (!M1 || !M2) {
+        printf("Received null matrix\n");
+        return S21Matrix();
+    } else if (!IntegerMatrix<std::int32_t>::FromMatrix(*M1, left) ||
+               !IntegerMatrix<std::int32_t>::FromMatrix(*M2, right)) {
+        printf("Matrix values should be int32 integers\n");
+        return S21Matrix();
+    }
+    IntegerMatrix<Acc> res = Solve(left, right, threads);
+    return res.is_empty() ? S21Matrix() : res.ToMatrix();
+}
+
+template <typename Acc>
+void IntegerWinogradAlgorithm<Acc>::Pack(const IntegerMatrix<std::int32_t> &M1,
+                                         const IntegerMatrix<std::int32_t> &M2) {
+    rows_ = M1.get_rows();
+    cols_ = M2.get_cols();
+    inner_ = M1.get_cols();
+    len_ = inner_ / 2;
+    std::uint64_t max_pair = MaxAbsValue(M1) + MaxAbsValue(M2);
+    pairs_fit_int32_ = max_pair <= (std::uint64_t)std::numeric_limits<std::int32_t>::max();
+
+    left_even_.resize((size_t)rows_ * len_);
+    left_odd_.resize((size_t)rows_ * len_);
+    left_last_.assign(rows_, 0);
+    row_factors_.assign(rows_, 0);
+    for (int i = 0; i < rows_; i++) {
+        for (int k = 0; k < len_; k++) {
+            left_even_[(size_t)i * len_ + k] = M1(i, 2 * k);
+            left_odd_[(size_t)i * len_ + k] = M1(i, 2 * k + 1);
+            row_factors_[i] += (Acc)M1(i, 2 * k) * M1(i, 2 * k + 1);
+        }
+        if (inner_ % 2 != 0) left_last_[i] = M1(i, inner_ - 1);
+    }
+
+    right_even_.resize((size_t)cols_ * len_);
+    right_odd_.resize((size_t)cols_ * len_);
+    right_last_.assign(cols_, 0);
+    column_factors_.assign(cols_, 0);
+    for (int k = 0; k < len_; k++) {
+        for (int j = 0; j < cols_; j++) {
+            right_even_[(size_t)j * len_ + k] = M2(2 * k, j);
+            right_odd_[(size_t)j * len_ + k] = M2(2 * k + 1, j);
+            column_factors_[j] += (Acc)M2(2 * k, j) * M2(2 * k + 1, j);
+        }
+    }
+    if (inner_ % 2 != 0) {
+        for (int j = 0; j < cols_; j++) right_last_[j] = M2(inner_ - 1, j);
+    }
+}
+
+template <typename Acc>
+void IntegerWinogradAlgorithm<Acc>::CalculateResultMatrixValues(IntegerMatrix<Acc> &res, int start_ind,
+                                                                int end_ind) {
+    for (int i = start_ind; i < end_ind; i++) {
+        const std::int32_t *ae = left_even_.data() + (size_t)i * len_;
+        const std::int32_t *ao = left_odd_.data() + (size_t)i * len_;
+        for (int j = 0; j < cols_; j++) {
+            const std::int32_t *be = right_even_.data() + (size_t)j * len_;
+            const std::int32_t *bo = right_odd_.data() + (size_t)j * len_;
+            Acc value = -row_factors_[i] - column_factors_[j];
+            value += DotProduct<Acc>(ae, ao, be, bo, len_, pairs_fit_int32_);
+            value += (Acc)left_last_[i] * right_last_[j];
+            res(i, j) = value;
+        }
+    }
+}
+
+template class IntegerWinogradAlgorithm<std::int32_t>;
+template class IntegerWinogradAlgorithm<std::int64_t>;
+
+}  // namespace s21
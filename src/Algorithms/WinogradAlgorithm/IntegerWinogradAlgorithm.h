@@ -0,0 +1,45 @@
+#ifndef PARALLELS_INTEGERWINOGRADALGORITHM_H
+#define PARALLELS_INTEGERWINOGRADALGORITHM_H
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "../../DataStructures/IntegerMatrix/IntegerMatrix.h"
+#include "../../DataStructures/Matrix/Matrix.h"
+#include "../../Utils/Executor/Executor.h"
+
+namespace s21 {
+
+// Exact Winograd multiplication of int32 matrices. Acc is the accumulator type, it is instantiated
+// for std::int32_t and std::int64_t. Before the multiplication the worst case value of every partial
+// sum is estimated from the maximum absolute values of the operands, and the multiplication is refused
+// if it may overflow Acc.
+template <typename Acc>
+class IntegerWinogradAlgorithm {
+public:
+    IntegerMatrix<Acc> Solve(const IntegerMatrix<std::int32_t> &M1, const IntegerMatrix<std::int32_t> &M2,
+                             int threads = 1);
+    S21Matrix Solve(S21Matrix *M1, S21Matrix *M2, int threads = 1);
+
+    static bool IsOverflowSafe(const IntegerMatrix<std::int32_t> &M1, const IntegerMatrix<std::int32_t> &M2);
+
+private:
+    int rows_, cols_, inner_, len_;
+    bool pairs_fit_int32_;
+    // Even and odd elements of M1 rows and M2 columns are stored separately, so the inner loop
+    // walks four contiguous arrays
+    std::vector<std::int32_t> left_even_, left_odd_, right_even_, right_odd_;
+    std::vector<std::int32_t> left_last_, right_last_;
+    std::vector<Acc> row_factors_, column_factors_;
+
+    void Pack(const IntegerMatrix<std::int32_t> &M1, const IntegerMatrix<std::int32_t> &M2);
+    void CalculateResultMatrixValues(IntegerMatrix<Acc> &res, int start_ind, int end_ind);
+};
+
+extern template class IntegerWinogradAlgorithm<std::int32_t>;
+extern template class IntegerWinogradAlgorithm<std::int64_t>;
+
+}  // namespace s21
+
+#endif  // PARALLELS_INTEGERWINOGRADALGORITHM_H
@@ -0,0 +1,108 @@
+#include "MatrixChain.h"
+
+namespace s21 {
+
+bool MatrixChain::SetOperands(const std::vector<S21Matrix *> &operands) {
+    operands_.clear();
+    dims_.clear();
+    cost_.clear();
+    split_.clear();
+    for (size_t i = 0; i < operands.size(); i++) {
+        if (!operands[i] || operands[i]->is_empty()) {
+            printf("Received null matrix\n");
+            return false;
+        } else if (i > 0 && operands[i - 1]->get_cols() != operands[i]->get_rows()) {
+            printf("Wrong matrix dimensions\n");
+            return false;
+        }
+    }
+    operands_ = operands;
+    if (!operands_.empty()) {
+        dims_.push_back(operands_[0]->get_rows());
+        for (S21Matrix *m : operands_) dims_.push_back(m->get_cols());
+        BuildPlan();
+    }
+    return true;
+}
+
+void MatrixChain::BuildPlan() {
+    int n = operands_.size();
+    cost_.assign(n, std::vector<Cost>(n));
+    split_.assign(n, std::vector<int>(n, -1));
+    for (int len = 2; len <= n; len++) {
+        for (int i = 0; i + len - 1 < n; i++) {
+            int j = i + len - 1;
+            std::uint64_t result_size = (std::uint64_t)dims_[i] * dims_[j + 1];
+            for (int k = i; k < j; k++) {
+                Cost cur;
+                cur.flops = cost_[i][k].flops + cost_[k + 1][j].flops +
+                            (std::uint64_t)dims_[i] * dims_[k + 1] * dims_[j + 1];
+                cur.memory = cost_[i][k].memory + cost_[k + 1][j].memory + result_size;
+                if (split_[i][j] == -1 || cur.flops < cost_[i][j].flops ||
+                    (cur.flops == cost_[i][j].flops && cur.memory < cost_[i][j].memory)) {
+                    cost_[i][j] = cur;
+                    split_[i][j] = k;
+                }
+            }
+        }
+    }
+}
+
+std::uint64_t MatrixChain::get_flops() const { return operands_.empty() ? 0 : cost_[0].back().flops; }
+
+std::uint64_t MatrixChain::get_memory() const { return operands_.empty() ? 0 : cost_[0].back().memory; }
+
+std::string MatrixChain::GetParenthesization() const {
+    return operands_.empty() ? "" : GetParenthesization(0, operands_.size() - 1);
+}
+
+std::string MatrixChain::GetParenthesization(int i, int j) const {
+    if (i == j) return "A" + std::to_string(i + 1);
+    return "(" + GetParenthesization(i, split_[i][j]) + GetParenthesization(split_[i][j] + 1, j) + ")";
+}
+
+S21Matrix MatrixChain::Solve(int threads) {
+    if (operands_.empty()) {
+        return S21Matrix();
+    }
+    S21Matrix product;
+    S21Matrix *result = Multiply(0, operands_.size() - 1, std::max(1, threads), product);
+    if (result != &product) {
+        return *result;
+    }
+    return product;
+}
+
+S21Matrix *MatrixChain::Multiply(int i, int j, int threads, S21Matrix &product) {
+    if (i == j) {
+        return operands_[i];
+    }
+    int k = split_[i][j];
+    S21Matrix left_product, right_product;
+    S21Matrix *left = nullptr, *right = nullptr;
+    if (threads > 1 && i < k && k + 1 < j) {
+        // Both halves are real products: share threads proportionally to their cost
+        double left_part =
+            (double)cost_[i][k].flops / std::max<std::uint64_t>(1, cost_[i][k].flops + cost_[k + 1][j].flops);
+        int left_threads = std::min(threads - 1, std::max(1, (int)(threads * left_part + 0.5)));
+        Executor::Instance().ParallelRun(2, [&](int id) {
+            if (id == 0) {
+                right = Multiply(k + 1, j, threads - left_threads, right_product);
+            } else {
+                left = Multiply(i, k, left_threads, left_product);
+            }
+        });
+    } else {
+        left = Multiply(i, k, threads, left_product);
+        right = Multiply(k + 1, j, threads, right_product);
+    }
+    WinogradAlgorithm algorithm;
+    if (threads > 1) {
+        product = algorithm.SolveWithClassicParallelism(left, right, threads);
+    } else {
+        product = algorithm.SolveWithoutParallelism(left, right);
+    }
+    return &product;
+}
+
+}  // namespace s21
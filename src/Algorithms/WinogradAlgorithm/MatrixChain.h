@@ -0,0 +1,44 @@
+#ifndef PARALLELS_MATRIXCHAIN_H
+#define PARALLELS_MATRIXCHAIN_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "../../DataStructures/Matrix/Matrix.h"
+#include "WinogradAlgorithm.h"
+
+namespace s21 {
+
+// Product of a chain of matrices. The order of multiplications is chosen by dynamic programming
+// over the number of scalar multiplications, ties are broken by the memory taken by intermediate
+// results. Independent sub-products are computed in parallel.
+class MatrixChain {
+public:
+    bool SetOperands(const std::vector<S21Matrix *> &operands);
+    S21Matrix Solve(int threads = 1);
+
+    std::uint64_t get_flops() const;
+    std::uint64_t get_memory() const;
+    std::string GetParenthesization() const;
+
+private:
+    struct Cost {
+        std::uint64_t flops = 0;
+        std::uint64_t memory = 0;
+    };
+
+    std::vector<S21Matrix *> operands_;
+    std::vector<int> dims_;
+    std::vector<std::vector<Cost>> cost_;
+    std::vector<std::vector<int>> split_;
+
+    void BuildPlan();
+    std::string GetParenthesization(int i, int j) const;
+    // Leaves are not copied: an operand is returned as is, a product is stored in the given matrix
+    S21Matrix *Multiply(int i, int j, int threads, S21Matrix &product);
+};
+
+}  // namespace s21
+
+#endif  // PARALLELS_MATRIXCHAIN_H
@@ -56,29 +56,15 @@ S21Matrix WinogradAlgorithm::SolveWithClassicParallelism(S21Matrix *M1, S21Matri
 
     SetupParameters(M1, M2);
 
-    int nmb_of_threads = threads_nmb;
-    std::vector<std::thread> threads(nmb_of_threads);
-
-    for (int i = 0; i < nmb_of_threads; i++) {
-        threads[i] =
-            std::thread(&WinogradAlgorithm::PrepareColumnAndRowFactors, this,
-                        i * M1_->get_rows() / nmb_of_threads, (i + 1) * M1_->get_rows() / nmb_of_threads,
-                        i * M2_->get_cols() / nmb_of_threads, (i + 1) * M2_->get_cols() / nmb_of_threads);
-    }
-
-    for (int i = 0; i < nmb_of_threads; i++) {
-        threads[i].join();
-    }
-
-    for (int i = 0; i < nmb_of_threads; i++) {
-        threads[i] =
-            std::thread(&WinogradAlgorithm::CalculateResultMatrixValues, this,
-                        i * M1_->get_rows() / nmb_of_threads, (i + 1) * M1_->get_rows() / nmb_of_threads);
-    }
-
-    for (int i = 0; i < nmb_of_threads; i++) {
-        threads[i].join();
-    }
+    int nmb_of_threads = std::max(1, threads_nmb);
+    Executor &executor = Executor::Instance();
+    int rows = M1_->get_rows(), cols = M2_->get_cols();
+    executor.ParallelRun(nmb_of_threads, [&](int i) {
+        PrepareColumnAndRowFactors(i * rows / nmb_of_threads, (i + 1) * rows / nmb_of_threads,
+                                   i * cols / nmb_of_threads, (i + 1) * cols / nmb_of_threads);
+    });
+    executor.ParallelFor(0, rows, 1, nmb_of_threads,
+                         [&](int begin, int end) { CalculateResultMatrixValues(begin, end); });
 
     delete[] row_factors_;
     delete[] column_factors_;
@@ -97,19 +83,17 @@ S21Matrix WinogradAlgorithm::SolveWithPipelineParallelism(S21Matrix *M1, S21Matr
 
     SetupParameters(M1, M2);
 
-    column_factors_ready_ = false;
-    row_factors_ready_ = false;
-    stage_three_ready_ = false;
-
-    std::thread t1(&WinogradAlgorithm::StageOne, this);
-    std::thread t2(&WinogradAlgorithm::StageTwo, this);
-    std::thread t3(&WinogradAlgorithm::StageThree, this);
-    std::thread t4(&WinogradAlgorithm::StageFour, this);
-
-    t1.join();
-    t2.join();
-    t3.join();
-    t4.join();
+    // Stages one to three write disjoint data, the fourth one needs all of them
+    Executor::Instance().ParallelRun(3, [this](int stage) {
+        if (stage == 0) {
+            StageOne();
+        } else if (stage == 1) {
+            StageTwo();
+        } else {
+            StageThree();
+        }
+    });
+    StageFour();
 
     delete[] row_factors_;
     delete[] column_factors_;
@@ -117,6 +101,63 @@ S21Matrix WinogradAlgorithm::SolveWithPipelineParallelism(S21Matrix *M1, S21Matr
     return res_;
 }
 
+S21Matrix WinogradAlgorithm::SolveWithPreparedOperand(S21Matrix *M1, WinogradPreparedOperand &M2,
+                                                     int threads_nmb) {
+    WinogradPreparedOperand left(M1, WinogradPreparedOperand::Side::kLeft);
+    return SolveWithPreparedOperands(left, M2, threads_nmb);
+}
+
+S21Matrix WinogradAlgorithm::SolveWithPreparedOperands(WinogradPreparedOperand &M1,
+                                                      WinogradPreparedOperand &M2, int threads_nmb) {
+    M1.Refresh();
+    M2.Refresh();
+    if (M1.is_empty() || M2.is_empty() || M1.get_side() != WinogradPreparedOperand::Side::kLeft ||
+        M2.get_side() != WinogradPreparedOperand::Side::kRight) {
+        printf("Received null matrix\n");
+        return S21Matrix();
+    } else if (M1.get_cols() != M2.get_rows()) {
+        printf("Wrong matrix dimensions\n");
+        return S21Matrix();
+    }
+
+    S21Matrix res(M1.get_rows(), M2.get_cols());
+    int nmb_of_threads = std::max(1, std::min(threads_nmb, M1.get_rows()));
+    if (nmb_of_threads == 1) {
+        CalculatePreparedResultValues(M1, M2, res, 0, M1.get_rows());
+        return res;
+    }
+
+    Executor::Instance().ParallelFor(0, M1.get_rows(), 1, nmb_of_threads, [&](int begin, int end) {
+        CalculatePreparedResultValues(M1, M2, res, begin, end);
+    });
+    return res;
+}
+
+void WinogradAlgorithm::CalculatePreparedResultValues(const WinogradPreparedOperand &M1,
+                                                      const WinogradPreparedOperand &M2, S21Matrix &res,
+                                                      int start_ind, int end_ind) {
+    int inner = M1.get_cols();
+    int len = inner / 2;
+    int cols = M2.get_cols();
+    const double *row_factors = M1.get_factors();
+    const double *column_factors = M2.get_factors();
+    for (int i = start_ind; i < end_ind; i++) {
+        const double *row = M1.get_vector(i);
+        double *res_row = &res(i, 0);
+        for (int j = 0; j < cols; j++) {
+            const double *column = M2.get_vector(j);
+            double value = -row_factors[i] - column_factors[j];
+            for (int k = 0; k < len; k++) {
+                value += (row[2 * k] + column[2 * k + 1]) * (row[2 * k + 1] + column[2 * k]);
+            }
+            if (inner % 2 != 0) {
+                value += row[inner - 1] * column[inner - 1];
+            }
+            res_row[j] = value;
+        }
+    }
+}
+
 void WinogradAlgorithm::CalculateRowFactors(int start_ind, int end_ind) {
     for (int i = start_ind; i < end_ind; i++) {
         row_factors_[i] = M1_->operator()(i, 0) * M1_->operator()(i, 1);
@@ -158,24 +199,11 @@ void WinogradAlgorithm::PrepareColumnAndRowFactors(int start_ind1, int end_ind1,
     CalculateColumnFactors(start_ind2, end_ind2);
 }
 
-void WinogradAlgorithm::StageOne() {
-    row_factors_mtx_.lock();
-    CalculateRowFactors(0, M1_->get_rows());
-    row_factors_ready_ = true;
-    row_factors_mtx_.unlock();
-    row_factors_cv_.notify_all();
-}
+void WinogradAlgorithm::StageOne() { CalculateRowFactors(0, M1_->get_rows()); }
 
-void WinogradAlgorithm::StageTwo() {
-    column_factors_mtx_.lock();
-    CalculateColumnFactors(0, M2_->get_cols());
-    column_factors_ready_ = true;
-    column_factors_mtx_.unlock();
-    column_factors_cv_.notify_all();
-}
+void WinogradAlgorithm::StageTwo() { CalculateColumnFactors(0, M2_->get_cols()); }
 
 void WinogradAlgorithm::StageThree() {
-    matrix_mtx_.lock();
     int res_cols = res_.get_cols();
     int M1_cols = M1_->get_cols();
     if (M1_cols % 2 != 0) {
@@ -186,20 +214,9 @@ void WinogradAlgorithm::StageThree() {
             }
         }
     }
-    stage_three_ready_ = true;
-    matrix_mtx_.unlock();
-    matrix_cv_.notify_all();
 }
 
 void WinogradAlgorithm::StageFour() {
-    std::unique_lock<std::mutex> ul(row_factors_mtx_);
-    std::unique_lock<std::mutex> ul2(column_factors_mtx_);
-    std::unique_lock<std::mutex> ul3(matrix_mtx_);
-
-    row_factors_cv_.wait(ul, [&] { return row_factors_ready_; });
-    column_factors_cv_.wait(ul2, [&] { return column_factors_ready_; });
-    matrix_cv_.wait(ul3, [&] { return stage_three_ready_; });
-
     int cols = res_.get_cols();
     for (int i = 0; i < M1_->get_rows(); i++) {
         for (int j = 0; j < cols; j++) {
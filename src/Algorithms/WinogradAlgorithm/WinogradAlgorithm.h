@@ -2,12 +2,12 @@
 #ifndef PARALLELS_WINOGRADALGORITHM_H
 #define PARALLELS_WINOGRADALGORITHM_H
 
-#include <condition_variable>
-#include <mutex>
-#include <thread>
+#include <algorithm>
 #include <vector>
 
 #include "../../DataStructures/Matrix/Matrix.h"
+#include "../../Utils/Executor/Executor.h"
+#include "WinogradPreparedOperand.h"
 
 namespace s21 {
 
@@ -17,11 +17,17 @@ public:
     S21Matrix SolveWithPipelineParallelism(S21Matrix *M1, S21Matrix *M2);
     S21Matrix SolveWithClassicParallelism(S21Matrix *M1, S21Matrix *M2, int threads);
 
+    // Multiplication with precomputed factors: stale operands are prepared again before use
+    S21Matrix SolveWithPreparedOperand(S21Matrix *M1, WinogradPreparedOperand &M2, int threads = 1);
+    S21Matrix SolveWithPreparedOperands(WinogradPreparedOperand &M1, WinogradPreparedOperand &M2,
+                                        int threads = 1);
+
 private:
     double *row_factors_;
     double *column_factors_;
-    S21Matrix *M1_;
-    S21Matrix *M2_;
+    // Only read, so the versions of the operands are not touched
+    const S21Matrix *M1_;
+    const S21Matrix *M2_;
     S21Matrix res_;
     int len_;
 
@@ -33,19 +39,11 @@ private:
     void CalculateColumnFactors(int start_ind, int end_ind);
     void CalculateResultMatrixValues(int start_ind, int end_ind);
     void PrepareColumnAndRowFactors(int start_ind1, int end_ind1, int start_ind2, int end_ind2);
+    static void CalculatePreparedResultValues(const WinogradPreparedOperand &M1,
+                                              const WinogradPreparedOperand &M2, S21Matrix &res,
+                                              int start_ind, int end_ind);
 
     // PIPELINE REALISATION //
-    std::mutex matrix_mtx_;
-    std::mutex row_factors_mtx_;
-    std::mutex column_factors_mtx_;
-    std::condition_variable row_factors_cv_;
-    std::condition_variable column_factors_cv_;
-    std::condition_variable matrix_cv_;
-
-    bool row_factors_ready_;
-    bool column_factors_ready_;
-    bool stage_three_ready_;
-
     void StageOne();
     void StageTwo();
     void StageThree();
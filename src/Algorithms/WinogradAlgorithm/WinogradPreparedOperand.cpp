@@ -0,0 +1,93 @@
+#include "WinogradPreparedOperand.h"
+
+namespace s21 {
+
+WinogradPreparedOperand::WinogradPreparedOperand()
+    : source_(nullptr), side_(Side::kRight), rows_(0), cols_(0), version_(0) {}
+
+WinogradPreparedOperand::WinogradPreparedOperand(const S21Matrix *matrix, Side side)
+    : WinogradPreparedOperand() {
+    Prepare(matrix, side);
+}
+
+void WinogradPreparedOperand::Prepare(const S21Matrix *matrix, Side side) {
+    source_ = matrix;
+    side_ = side;
+    factors_.clear();
+    packed_.clear();
+    if (!source_) {
+        rows_ = cols_ = 0;
+        return;
+    }
+    version_ = source_->get_version();
+    rows_ = source_->get_rows();
+    cols_ = source_->get_cols();
+    if (side_ == Side::kLeft) {
+        PrepareLeft();
+    } else {
+        PrepareRight();
+    }
+}
+
+bool WinogradPreparedOperand::IsActual() const { return source_ && source_->get_version() == version_; }
+
+void WinogradPreparedOperand::Refresh() {
+    if (source_ && !IsActual()) {
+        Prepare(source_, side_);
+    }
+}
+
+void WinogradPreparedOperand::PrepareLeft() {
+    const S21Matrix &m = *source_;
+    int len = cols_ / 2;
+    factors_.assign(rows_, 0.0);
+    for (int i = 0; i < rows_; i++) {
+        const double *row = &m(i, 0);
+        double factor = 0.0;
+        for (int k = 0; k < len; k++) {
+            factor += row[2 * k] * row[2 * k + 1];
+        }
+        factors_[i] = factor;
+    }
+}
+
+void WinogradPreparedOperand::PrepareRight() {
+    const S21Matrix &m = *source_;
+    int len = rows_ / 2;
+    packed_.resize(static_cast<size_t>(rows_) * cols_);
+    for (int k = 0; k < rows_; k++) {
+        for (int j = 0; j < cols_; j++) {
+            packed_[static_cast<size_t>(j) * rows_ + k] = m(k, j);
+        }
+    }
+    factors_.assign(cols_, 0.0);
+    for (int j = 0; j < cols_; j++) {
+        const double *column = get_vector(j);
+        double factor = 0.0;
+        for (int k = 0; k < len; k++) {
+            factor += column[2 * k] * column[2 * k + 1];
+        }
+        factors_[j] = factor;
+    }
+}
+
+bool WinogradPreparedOperand::is_empty() const { return !source_ || !rows_ || !cols_; }
+
+WinogradPreparedOperand::Side WinogradPreparedOperand::get_side() const { return side_; }
+
+int WinogradPreparedOperand::get_rows() const { return rows_; }
+
+int WinogradPreparedOperand::get_cols() const { return cols_; }
+
+const S21Matrix *WinogradPreparedOperand::get_source() const { return source_; }
+
+const double *WinogradPreparedOperand::get_factors() const { return factors_.data(); }
+
+const double *WinogradPreparedOperand::get_vector(int ind) const {
+    if (side_ == Side::kLeft) {
+        return &(*source_)(ind, 0);
+    }
+    return packed_.data() + static_cast<size_t>(ind) * rows_;
+}
+
+}  // namespace s21
@@ -0,0 +1,48 @@
+#ifndef PARALLELS_WINOGRADPREPAREDOPERAND_H
+#define PARALLELS_WINOGRADPREPAREDOPERAND_H
+
+#include <cstdint>
+#include <vector>
+
+#include "../../DataStructures/Matrix/Matrix.h"
+
+namespace s21 {
+
+// Operand of Winograd multiplication with precomputed factors. Left operand keeps row factors,
+// right operand keeps column factors and columns packed contiguously. The source matrix is not
+// copied for the left side, so it must outlive the prepared operand.
+class WinogradPreparedOperand {
+public:
+    enum class Side { kLeft, kRight };
+
+    WinogradPreparedOperand();
+    WinogradPreparedOperand(const S21Matrix *matrix, Side side);
+
+    void Prepare(const S21Matrix *matrix, Side side);
+    bool IsActual() const;
+    void Refresh();
+
+    bool is_empty() const;
+    Side get_side() const;
+    int get_rows() const;
+    int get_cols() const;
+    const S21Matrix *get_source() const;
+    const double *get_factors() const;
+    const double *get_vector(int ind) const;
+
+private:
+    const S21Matrix *source_;
+    Side side_;
+    int rows_;
+    int cols_;
+    std::uint64_t version_;
+    std::vector<double> factors_;
+    std::vector<double> packed_;
+
+    void PrepareLeft();
+    void PrepareRight();
+};
+
+}  // namespace s21
+
+#endif  // PARALLELS_WINOGRADPREPAREDOPERAND_H
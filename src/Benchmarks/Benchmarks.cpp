@@ -0,0 +1,206 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cmath>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "../Algorithms/AntColonyAlgorithm/AntAlgorithm.h"
+#include "../Algorithms/GaussAlgorithm/GaussAlgorithm.h"
+#include "../Algorithms/WinogradAlgorithm/WinogradAlgorithm.h"
+#include "../DataStructures/Matrix/Matrix.h"
+
+namespace {
+constexpr std::uint64_t kSeed = 21;
+constexpr int kAntIterations = 10;
+
+// Counts of threads of scaling sweeps: powers of two up to the hardware threads and the count itself
+std::vector<int> ThreadCounts() {
+    int hardware = std::max(1, (int)std::thread::hardware_concurrency());
+    std::vector<int> counts;
+    for (int threads = 1; threads < hardware; threads *= 2) counts.push_back(threads);
+    counts.push_back(hardware);
+    return counts;
+}
+
+// Arguments are {size, threads}. Strong scaling keeps the size, weak scaling grows it with threads so
+// that the work of one thread stays the same for algorithms of cubic complexity
+void StrongScaling(benchmark::internal::Benchmark *bench, const std::vector<int> &sizes) {
+    bench->ArgNames({"size", "threads"});
+    for (int size : sizes) {
+        for (int threads : ThreadCounts()) bench->Args({size, threads});
+    }
+}
+
+void WeakScaling(benchmark::internal::Benchmark *bench, int base_size) {
+    bench->ArgNames({"size", "threads"});
+    for (int threads : ThreadCounts()) {
+        bench->Args({(int)std::lround(base_size * std::cbrt(threads)), threads});
+    }
+}
+
+void Sizes(benchmark::internal::Benchmark *bench, const std::vector<int> &sizes) {
+    bench->ArgNames({"size"});
+    for (int size : sizes) bench->Args({size});
+}
+
+s21::S21Matrix RandomMatrix(int rows, int cols, std::uint64_t seed = kSeed) {
+    s21::S21Matrix matrix(rows, cols);
+    s21::S21Matrix::FillMatrixWithRandValues(&matrix, seed);
+    return matrix;
+}
+
+// Diagonal dominance keeps the system solvable without pivoting
+s21::S21Matrix RandomSystem(int size) {
+    s21::S21Matrix matrix = RandomMatrix(size, size + 1);
+    for (int i = 0; i < size; ++i) matrix(i, i) += 100.0 * size;
+    return matrix;
+}
+
+void SetFlops(benchmark::State &state, double flops_per_run) {
+    state.counters["FLOPS"] = benchmark::Counter(flops_per_run, benchmark::Counter::kIsIterationInvariantRate,
+                                                 benchmark::Counter::kIs1000);
+}
+
+// Forward elimination and back substitution
+double GaussFlops(double n) { return 2.0 / 3.0 * n * n * n + 2.0 * n * n; }
+double MultiplicationFlops(double n) { return 2.0 * n * n * n; }
+
+void BM_GaussSerial(benchmark::State &state) {
+    s21::S21Matrix matrix = RandomSystem(state.range(0));
+    s21::GaussAlgorithm gauss;
+    for (auto _ : state) {
+        // The solver takes the system by value and changes it, the copy is made outside of the timing
+        state.PauseTiming();
+        s21::S21Matrix system(matrix);
+        state.ResumeTiming();
+        benchmark::DoNotOptimize(gauss.SolveWithoutUsingParallelism(std::move(system)));
+    }
+    SetFlops(state, GaussFlops(state.range(0)));
+}
+
+void BM_GaussParallel(benchmark::State &state) {
+    s21::S21Matrix matrix = RandomSystem(state.range(0));
+    s21::GaussAlgorithm gauss;
+    for (auto _ : state) {
+        // The solver takes the system by value and changes it, the copy is made outside of the timing
+        state.PauseTiming();
+        s21::S21Matrix system(matrix);
+        state.ResumeTiming();
+        benchmark::DoNotOptimize(gauss.SolveUsingParallelism(std::move(system), state.range(1)));
+    }
+    SetFlops(state, GaussFlops(state.range(0)));
+}
+
+void BM_WinogradSerial(benchmark::State &state) {
+    s21::S21Matrix M1 = RandomMatrix(state.range(0), state.range(0));
+    s21::S21Matrix M2 = RandomMatrix(state.range(0), state.range(0), kSeed + 1);
+    s21::WinogradAlgorithm winograd;
+    for (auto _ : state) benchmark::DoNotOptimize(winograd.SolveWithoutParallelism(&M1, &M2));
+    SetFlops(state, MultiplicationFlops(state.range(0)));
+}
+
+void BM_WinogradPipeline(benchmark::State &state) {
+    s21::S21Matrix M1 = RandomMatrix(state.range(0), state.range(0));
+    s21::S21Matrix M2 = RandomMatrix(state.range(0), state.range(0), kSeed + 1);
+    s21::WinogradAlgorithm winograd;
+    for (auto _ : state) benchmark::DoNotOptimize(winograd.SolveWithPipelineParallelism(&M1, &M2));
+    SetFlops(state, MultiplicationFlops(state.range(0)));
+}
+
+void BM_WinogradClassic(benchmark::State &state) {
+    s21::S21Matrix M1 = RandomMatrix(state.range(0), state.range(0));
+    s21::S21Matrix M2 = RandomMatrix(state.range(0), state.range(0), kSeed + 1);
+    s21::WinogradAlgorithm winograd;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(winograd.SolveWithClassicParallelism(&M1, &M2, state.range(1)));
+    }
+    SetFlops(state, MultiplicationFlops(state.range(0)));
+}
+
+// Zero distances are missing edges, so distances start from 1
+void SetAntData(s21::AntAlgorithm &ant, int size, int threads) {
+    s21::S21Matrix matrix = RandomMatrix(size, size);
+    for (int i = 0; i < size; ++i) {
+        for (int j = 0; j < size; ++j) matrix(i, j) = i == j ? 0.0 : matrix(i, j) + 1.0;
+    }
+    ant.SetData(matrix, kAntIterations);
+    s21::AntParameters parameters = ant.GetParameters();
+    parameters.ants = size;
+    parameters.threads = threads;
+    parameters.seed = kSeed;
+    ant.SetParameters(parameters);
+}
+
+void BM_AntSerial(benchmark::State &state) {
+    s21::AntAlgorithm ant;
+    SetAntData(ant, state.range(0), 1);
+    for (auto _ : state) ant.SolveWithoutUsingParallelism();
+    state.counters["ant_iterations"] =
+        benchmark::Counter(kAntIterations, benchmark::Counter::kIsIterationInvariantRate);
+}
+
+void BM_AntParallel(benchmark::State &state) {
+    s21::AntAlgorithm ant;
+    SetAntData(ant, state.range(0), state.range(1));
+    for (auto _ : state) ant.SolveUsingParallelism();
+    state.counters["ant_iterations"] =
+        benchmark::Counter(kAntIterations, benchmark::Counter::kIsIterationInvariantRate);
+}
+
+void BM_MatrixMultiplication(benchmark::State &state) {
+    s21::S21Matrix M1 = RandomMatrix(state.range(0), state.range(0));
+    s21::S21Matrix M2 = RandomMatrix(state.range(0), state.range(0), kSeed + 1);
+    for (auto _ : state) benchmark::DoNotOptimize(M1 * M2);
+    SetFlops(state, MultiplicationFlops(state.range(0)));
+}
+
+void BM_MatrixSum(benchmark::State &state) {
+    s21::S21Matrix M1 = RandomMatrix(state.range(0), state.range(0));
+    s21::S21Matrix M2 = RandomMatrix(state.range(0), state.range(0), kSeed + 1);
+    for (auto _ : state) benchmark::DoNotOptimize(M1 + M2);
+    SetFlops(state, (double)state.range(0) * state.range(0));
+}
+
+void BM_MatrixTranspose(benchmark::State &state) {
+    s21::S21Matrix matrix = RandomMatrix(state.range(0), state.range(0));
+    for (auto _ : state) benchmark::DoNotOptimize(matrix.transpose());
+    state.SetBytesProcessed(state.iterations() * state.range(0) * state.range(0) * sizeof(double));
+}
+}  // namespace
+
+BENCHMARK(BM_GaussSerial)->Apply([](auto *bench) { Sizes(bench, {64, 128, 256, 512}); });
+BENCHMARK(BM_GaussParallel)
+    ->Apply([](auto *bench) { StrongScaling(bench, {256, 512}); })
+    ->UseRealTime();
+BENCHMARK(BM_GaussParallel)
+    ->Name("BM_GaussParallel/weak")
+    ->Apply([](auto *bench) { WeakScaling(bench, 256); })
+    ->UseRealTime();
+
+BENCHMARK(BM_WinogradSerial)->Apply([](auto *bench) { Sizes(bench, {64, 128, 256}); });
+BENCHMARK(BM_WinogradPipeline)
+    ->Apply([](auto *bench) { Sizes(bench, {64, 128, 256}); })
+    ->UseRealTime();
+BENCHMARK(BM_WinogradClassic)
+    ->Apply([](auto *bench) { StrongScaling(bench, {128, 256}); })
+    ->UseRealTime();
+BENCHMARK(BM_WinogradClassic)
+    ->Name("BM_WinogradClassic/weak")
+    ->Apply([](auto *bench) { WeakScaling(bench, 128); })
+    ->UseRealTime();
+
+BENCHMARK(BM_AntSerial)
+    ->Apply([](auto *bench) { Sizes(bench, {50, 100, 200}); })
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_AntParallel)
+    ->Apply([](auto *bench) { StrongScaling(bench, {100, 200}); })
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK(BM_MatrixMultiplication)->Apply([](auto *bench) { Sizes(bench, {64, 128, 256}); });
+BENCHMARK(BM_MatrixSum)->Apply([](auto *bench) { Sizes(bench, {256, 1024}); });
+BENCHMARK(BM_MatrixTranspose)->Apply([](auto *bench) { Sizes(bench, {256, 1024}); });
+
+BENCHMARK_MAIN();
@@ -2,8 +2,13 @@
 #ifndef PARALLELS_ABSTRACTCONSOLEENGINE_H
 #define PARALLELS_ABSTRACTCONSOLEENGINE_H
 
+#include <fstream>
 #include <iostream>
 #include <string>
+#include <vector>
+
+#include "Batch/BatchOptions.h"
+#include "Batch/BatchReport.h"
 
 using std::cout;
 using std::endl;
@@ -22,11 +27,39 @@ public:
         PrintResult();
     }
 
+    // Measures the modes chosen by the options without questions and writes a record per mode.
+    // Returns the exit code of the program
+    int StartBatch(const BatchOptions &options) {
+        if (!options.algorithm.empty() && options.algorithm != algorithm_name_) {
+            std::cerr << "This program runs " << algorithm_name_ << ", not " << options.algorithm << endl;
+            return 1;
+        }
+        // A typo in a mode would otherwise give an empty report and a successful exit
+        if (!options.CheckModes(batch_modes_)) {
+            return 1;
+        }
+        std::ofstream file;
+        if (!options.output.empty()) {
+            file.open(options.output);
+            if (!file.is_open()) {
+                std::cerr << "Can't open " << options.output << " for writing" << endl;
+                return 1;
+            }
+        }
+        BatchReport report(options.output.empty() ? cout : file, options.format);
+        return RunBatch(options, report) ? 0 : 1;
+    }
+
 protected:
     string start_message_;
+    string algorithm_name_;
+    std::vector<string> batch_modes_;
     virtual void RequestParamsFromUser() = 0;
     virtual void RunAlgorithm() = 0;
     virtual void PrintResult() = 0;
+    // Returns false if the input can't be loaded
+    virtual bool RunBatch(const BatchOptions &options, BatchReport &report) = 0;
+
 };
 
 }  // namespace s21
@@ -0,0 +1,132 @@
+#include "BatchOptions.h"
+
+#include <algorithm>
+#include <iostream>
+#include <sstream>
+
+namespace s21 {
+namespace {
+bool ReadNumber(const std::string &flag, const std::string &value, long long bottom_border,
+                long long &number) {
+    std::size_t parsed = 0;
+    try {
+        number = std::stoll(value, &parsed);
+    } catch (const std::exception &) {
+        parsed = 0;
+    }
+    if (parsed == 0 || parsed != value.size() || number < bottom_border) {
+        std::cerr << "Wrong value of " << flag << ": " << value << ", an integer not less than "
+                  << bottom_border << " is expected\n";
+        return false;
+    }
+    return true;
+}
+
+std::vector<std::string> SplitList(const std::string &value) {
+    std::vector<std::string> items;
+    std::stringstream stream(value);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        if (!item.empty()) items.push_back(item);
+    }
+    return items;
+}
+}  // namespace
+
+bool BatchOptions::HasMode(const std::string &mode) const {
+    return modes.empty() || std::find(modes.begin(), modes.end(), mode) != modes.end();
+}
+
+bool BatchOptions::CheckModes(const std::vector<std::string> &known) const {
+    for (const std::string &mode : modes) {
+        if (std::find(known.begin(), known.end(), mode) == known.end()) {
+            std::cerr << "Unknown mode: " << mode << ", known modes:";
+            for (const std::string &name : known) std::cerr << " " << name;
+            std::cerr << "\n";
+            return false;
+        }
+    }
+    return true;
+}
+
+bool BatchOptions::Parse(int argc, char *argv[], BatchOptions &options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string flag = argv[i];
+        if (flag == "--help") {
+            PrintUsage(argv[0]);
+            return false;
+        }
+        if (i + 1 == argc) {
+            std::cerr << "Value of " << flag << " is missing\n";
+            PrintUsage(argv[0]);
+            return false;
+        }
+        std::string value = argv[++i];
+        long long number = 0;
+        bool correct = true;
+        if (flag == "--algorithm") {
+            options.algorithm = value;
+        } else if (flag == "--mode") {
+            options.modes = SplitList(value);
+        } else if (flag == "--input") {
+            std::vector<std::string> inputs = SplitList(value);
+            options.inputs.insert(options.inputs.end(), inputs.begin(), inputs.end());
+        } else if (flag == "--size") {
+            correct = ReadNumber(flag, value, 2, number);
+            options.size = number;
+        } else if (flag == "--seed") {
+            correct = ReadNumber(flag, value, 0, number);
+            options.seed = number;
+        } else if (flag == "--threads") {
+            correct = ReadNumber(flag, value, 1, number);
+            options.threads = number;
+        } else if (flag == "--repetitions") {
+            correct = ReadNumber(flag, value, 1, number);
+            options.repetitions = number;
+        } else if (flag == "--warmups") {
+            correct = ReadNumber(flag, value, 0, number);
+            options.warmups = number;
+        } else if (flag == "--iterations") {
+            correct = ReadNumber(flag, value, 1, number);
+            options.iterations = number;
+        } else if (flag == "--ants") {
+            correct = ReadNumber(flag, value, 1, number);
+            options.ants = number;
+        } else if (flag == "--format" && (value == "json" || value == "csv")) {
+            options.format = value == "json" ? BatchFormat::kJson : BatchFormat::kCsv;
+        } else if (flag == "--output") {
+            options.output = value;
+        } else {
+            std::cerr << "Unknown flag or value: " << flag << " " << value << "\n";
+            correct = false;
+        }
+        if (!correct) {
+            PrintUsage(argv[0]);
+            return false;
+        }
+    }
+    if (options.inputs.empty() && options.size == 0) {
+        std::cerr << "Either --input or --size is required\n";
+        PrintUsage(argv[0]);
+        return false;
+    }
+    return true;
+}
+
+void BatchOptions::PrintUsage(const char *program) {
+    std::cerr << "Usage: " << program << " (--input FILE[,FILE] | --size N) [flags]\n"
+              << "  --algorithm NAME     ant, gauss or winograd, checked against the binary\n"
+              << "  --mode M[,M...]      modes to measure, all modes by default\n"
+              << "  --seed S             seed of generated data and of the ants, 21 by default\n"
+              << "  --threads T          threads of parallel modes\n"
+              << "  --repetitions R      timed runs of every mode, 1 by default\n"
+              << "  --warmups W          untimed runs of every mode before the timed ones, 1 by default\n"
+              << "  --iterations N       iterations of the ant colony, 100 by default\n"
+              << "  --ants N             ants per iteration of the ant colony\n"
+              << "  --format json|csv    format of the records, json by default\n"
+              << "  --output FILE        file for the records, standard output by default\n"
+              << "Modes: ant - serial, parallel; gauss - serial, parallel;\n"
+              << "       winograd - serial, pipeline, classic, prepared, integer\n";
+}
+
+}  // namespace s21
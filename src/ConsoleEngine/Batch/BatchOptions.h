@@ -0,0 +1,38 @@
+#ifndef PARALLELS_BATCHOPTIONS_H
+#define PARALLELS_BATCHOPTIONS_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace s21 {
+
+enum class BatchFormat { kJson, kCsv };
+
+// Parameters of a non-interactive run, given as command-line flags. Zero size and threads mean
+// "not set": the input file is read and every engine picks its own count of threads
+struct BatchOptions {
+    std::string algorithm;            // must match the engine the binary is built for, if given
+    std::vector<std::string> modes;   // modes to measure, all modes of the engine if empty
+    std::vector<std::string> inputs;  // files with matrices or a TSPLIB instance
+    int size = 0;                     // edge of generated matrices or count of generated nodes
+    std::uint64_t seed = 21;
+    int threads = 0;
+    int repetitions = 1;
+    int warmups = 1;       // untimed runs of every mode before the timed ones
+    int iterations = 100;  // ant colony only
+    int ants = 0;          // ant colony only, 0 keeps the default
+    BatchFormat format = BatchFormat::kJson;
+    std::string output;  // file for the records, standard output if empty
+
+    bool HasMode(const std::string &mode) const;
+    // Prints the first mode that is not known to the engine to stderr and returns false
+    bool CheckModes(const std::vector<std::string> &known) const;
+    // Prints the problem and the usage to stderr and returns false on a wrong command line
+    static bool Parse(int argc, char *argv[], BatchOptions &options);
+    static void PrintUsage(const char *program);
+};
+
+}  // namespace s21
+
+#endif  // PARALLELS_BATCHOPTIONS_H
@@ -0,0 +1,83 @@
+#include "BatchReport.h"
+
+#include <cmath>
+#include <cstdio>
+
+namespace s21 {
+namespace {
+std::string Quote(const std::string &value, BatchFormat format) {
+    std::string quoted = "\"";
+    for (char ch : value) {
+        if (ch == '"') {
+            quoted += format == BatchFormat::kJson ? "\\\"" : "\"\"";
+        } else if (ch == '\\' && format == BatchFormat::kJson) {
+            quoted += "\\\\";
+        } else {
+            quoted += ch;
+        }
+    }
+    return quoted + "\"";
+}
+
+// JSON has no NaN or infinity, an infinite distance of a disconnected graph is written as null
+std::string Number(double value, int precision, BatchFormat format) {
+    if (format == BatchFormat::kJson && !std::isfinite(value)) return "null";
+    char buffer[64];
+    std::snprintf(buffer, sizeof(buffer), "%.*g", precision, value);
+    return buffer;
+}
+}  // namespace
+
+BatchReport::BatchReport(std::ostream &out, BatchFormat format) : out_(out), format_(format) {
+    if (format_ == BatchFormat::kCsv) {
+        out_ << "algorithm,mode,input,rows,cols,threads,seed,repetitions,min_seconds,median_seconds,"
+                "p90_seconds,p99_seconds,mean_seconds,stddev_seconds,outliers,checksum\n";
+    } else {
+        out_ << "[";
+    }
+}
+
+BatchReport::~BatchReport() {
+    if (format_ == BatchFormat::kJson) out_ << (records_ > 0 ? "\n]\n" : "]\n");
+    out_.flush();
+}
+
+void BatchReport::Write(const BatchRecord &record) {
+    const TimingStats &timing = record.timing;
+    std::vector<std::pair<std::string, std::string>> fields = {
+        {"algorithm", Quote(record.algorithm, format_)},
+        {"mode", Quote(record.mode, format_)},
+        {"input", Quote(record.input, format_)},
+        {"rows", std::to_string(record.rows)},
+        {"cols", std::to_string(record.cols)},
+        {"threads", std::to_string(record.threads)},
+        {"seed", std::to_string(record.seed)},
+        {"repetitions", std::to_string(timing.samples.size())},
+        {"min_seconds", Number(timing.min, 9, format_)},
+        {"median_seconds", Number(timing.median, 9, format_)},
+        {"p90_seconds", Number(timing.p90, 9, format_)},
+        {"p99_seconds", Number(timing.p99, 9, format_)},
+        {"mean_seconds", Number(timing.mean, 9, format_)},
+        {"stddev_seconds", Number(timing.stddev, 9, format_)},
+        {"outliers", std::to_string(timing.outliers)},
+        {"checksum", Number(record.checksum, 17, format_)}};
+    if (format_ == BatchFormat::kJson) out_ << (records_ > 0 ? ",\n  {" : "\n  {");
+    for (size_t i = 0; i < fields.size(); ++i) {
+        if (i > 0) out_ << (format_ == BatchFormat::kJson ? ", " : ",");
+        if (format_ == BatchFormat::kJson) out_ << "\"" << fields[i].first << "\": ";
+        out_ << fields[i].second;
+    }
+    out_ << (format_ == BatchFormat::kJson ? "}" : "\n");
+    out_.flush();
+    records_++;
+}
+
+double BatchReport::Checksum(const S21Matrix &matrix) {
+    double sum = 0.0;
+    for (int i = 0; i < matrix.get_rows(); ++i) {
+        for (int j = 0; j < matrix.get_cols(); ++j) sum += matrix(i, j);
+    }
+    return sum;
+}
+
+}  // namespace s21
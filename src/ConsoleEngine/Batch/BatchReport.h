@@ -0,0 +1,48 @@
+#ifndef PARALLELS_BATCHREPORT_H
+#define PARALLELS_BATCHREPORT_H
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+#include "../../DataStructures/Matrix/Matrix.h"
+#include "../../Utils/Timing/TimingHarness.h"
+#include "BatchOptions.h"
+
+namespace s21 {
+
+// Measurement of one mode: statistics of its runs and a checksum of the result, so runs of different
+// modes, threads and builds can be compared
+struct BatchRecord {
+    std::string algorithm;
+    std::string mode;
+    std::string input;  // file name or "generated"
+    int rows = 0;
+    int cols = 0;
+    int threads = 1;
+    std::uint64_t seed = 0;
+    TimingStats timing;
+    double checksum = 0.0;
+};
+
+// Writes records as a JSON array of objects or as CSV with a header, one record per line
+class BatchReport {
+public:
+    BatchReport(std::ostream &out, BatchFormat format);
+    ~BatchReport();
+    BatchReport(const BatchReport &) = delete;
+    BatchReport &operator=(const BatchReport &) = delete;
+
+    void Write(const BatchRecord &record);
+    // Sum of all elements, the same for equal results of different modes up to rounding
+    static double Checksum(const S21Matrix &matrix);
+
+private:
+    std::ostream &out_;
+    BatchFormat format_;
+    int records_ = 0;
+};
+
+}  // namespace s21
+
+#endif  // PARALLELS_BATCHREPORT_H
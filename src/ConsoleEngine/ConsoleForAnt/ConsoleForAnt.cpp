@@ -5,6 +5,8 @@ ConsoleForAnt::ConsoleForAnt() : AbstractConsoleEngine() {
     start_message_ = "This program allows to test performance in "\
         "Ant Colony Algorithm and compare multithreading and single thread "\
         "implementation.\n";
+    algorithm_name_ = "ant";
+    batch_modes_ = {"serial", "parallel"};
 }
 
 void ConsoleForAnt::WrongInputMessage() {
@@ -26,6 +28,17 @@ void ConsoleForAnt::RequestParamsFromUser() {
     int N, rows;
     cout << "Enter the count of iterations:\n";
     N = InputValue(1);
+    cout << "Enter the count of timed solves of every mode:\n";
+    repetitions_ = InputValue(1);
+    cout << "Enter the path to TSPLIB file or 0 to enter the matrix:\n";
+    std::string path;
+    std::cin >> path;
+    if (path != "0") {
+        std::shared_ptr<DistanceProvider> graph = LoadTsplib(path);
+        ant_solver_.SetData(graph, N);
+        RequestSolverParams();
+        return;
+    }
     cout << "Enter the edge of square matrix:\n";
     rows = InputValue(2);
     S21Matrix matrix(rows, rows);
@@ -44,23 +57,133 @@ void ConsoleForAnt::RequestParamsFromUser() {
         }
     }
     ant_solver_.SetData(matrix, N);
+    RequestSolverParams();
+}
+
+std::shared_ptr<DistanceProvider> ConsoleForAnt::LoadTsplib(std::string path) {
+    while (true) {
+        std::ifstream file(path);
+        std::shared_ptr<DistanceProvider> graph = TsplibLoader::Load(file);
+        if (graph != nullptr && graph->get_size() >= 2) {
+            return graph;
+        }
+        cout << "Can't read TSPLIB instance from the file! Enter another path:\n";
+        std::cin >> path;
+    }
+}
+
+void ConsoleForAnt::RequestSolverParams() {
+    AntParameters parameters = ant_solver_.GetParameters();
+    cout << "Enter the count of ants in iteration:\n";
+    parameters.ants = InputValue(1);
+    cout << "Enter the maximal count of threads (" << parameters.threads << " on this machine):\n";
+    parameters.threads = InputValue(1);
+    cout << "Enter the seed of ants random generator:\n";
+    parameters.seed = InputValue(0);
+    cout << "Enter the local search mode (0 - none, 1 - best tours of iteration, 2 - all tours):\n";
+    int mode = InputValue(0);
+    while (mode > 2) {
+        WrongInputMessage();
+        mode = InputValue(0);
+    }
+    parameters.local_search = static_cast<LocalSearchMode>(mode);
+    cout << "Enter the pheromone update rule "\
+        "(0 - Ant System, 1 - MAX-MIN Ant System, 2 - Ant Colony System):\n";
+    int system = InputValue(0);
+    while (system > 2) {
+        WrongInputMessage();
+        system = InputValue(0);
+    }
+    parameters.system = static_cast<AntSystem>(system);
+    cout << "Enter the count of islands (1 - one colony shared by all threads):\n";
+    parameters.islands = InputValue(1);
+    cout << "Enter the pheromone storage (0 - dense, 1 - symmetric, 2 - candidate edges only):\n";
+    int storage = InputValue(0);
+    while (storage > 2) {
+        WrongInputMessage();
+        storage = InputValue(0);
+    }
+    parameters.pheromone_storage = static_cast<EdgeStorage>(storage);
+    try {
+        ant_solver_.SetParameters(parameters);
+    } catch (const char *message) {
+        cout << message << ", dense storage is used\n";
+        parameters.pheromone_storage = EdgeStorage::kDense;
+        ant_solver_.SetParameters(parameters);
+    }
     cout << "End of initialization\n\n";
 }
 
 void ConsoleForAnt::RunAlgorithm() {
-    auto start = std::chrono::steady_clock::now();
-    ant_solver_.SolveWithoutUsingParallelism();
-    duration_without_parallelism_ = std::chrono::steady_clock::now() - start;
+    TimingHarness harness(repetitions_);
+    stats_without_parallelism_ = harness.Measure([&] { ant_solver_.SolveWithoutUsingParallelism(); });
     single_thread_result_ = ant_solver_.GetResult();
 
-    start = std::chrono::steady_clock::now();
-    ant_solver_.SolveUsingParallelism();
-    duration_with_parallelism_ = std::chrono::steady_clock::now() - start;
+    // With one thread there is nothing to compare, the previous multithread stats must not be shown
+    stats_with_parallelism_ = TimingStats();
+    speedup_curve_.assign(1, {1, stats_without_parallelism_.median});
+    int max_threads = ant_solver_.GetParameters().threads;
+    for (int threads = 2; threads < 2 * max_threads; threads *= 2) {
+        threads = std::min(threads, max_threads);
+        stats_with_parallelism_ = harness.Measure([&] { ant_solver_.SolveUsingThreads(threads); });
+        speedup_curve_.push_back({threads, stats_with_parallelism_.median});
+    }
     multithread_result_ = ant_solver_.GetResult();
+    local_search_time_ = ant_solver_.GetLocalSearchTime();
+}
+
+bool ConsoleForAnt::RunBatch(const BatchOptions &options, BatchReport &report) {
+    BatchRecord record;
+    record.algorithm = algorithm_name_;
+    record.seed = options.seed;
+    if (!options.inputs.empty()) {
+        std::ifstream file(options.inputs[0]);
+        std::shared_ptr<DistanceProvider> graph = TsplibLoader::Load(file);
+        if (graph == nullptr || graph->get_size() < 2) {
+            std::cerr << "Can't read TSPLIB instance from " << options.inputs[0] << endl;
+            return false;
+        }
+        ant_solver_.SetData(graph, options.iterations);
+        record.input = options.inputs[0];
+        record.rows = record.cols = graph->get_size();
+    } else {
+        // Zero distances are missing edges, so generated distances start from 1
+        S21Matrix matrix(options.size, options.size);
+        S21Matrix::FillMatrixWithRandValues(&matrix, options.seed);
+        for (int i = 0; i < options.size; i++) {
+            for (int j = 0; j < options.size; j++) {
+                matrix(i, j) = i == j ? 0.0 : matrix(i, j) + 1.0;
+            }
+        }
+        ant_solver_.SetData(matrix, options.iterations);
+        record.input = "generated";
+        record.rows = record.cols = options.size;
+    }
+    AntParameters parameters = ant_solver_.GetParameters();
+    parameters.seed = options.seed;
+    if (options.threads > 0) parameters.threads = options.threads;
+    if (options.ants > 0) parameters.ants = options.ants;
+    ant_solver_.SetParameters(parameters);
+
+    TimingHarness harness(options.repetitions, options.warmups);
+    if (options.HasMode("serial")) {
+        record.mode = "serial";
+        record.timing = harness.Measure([&] { ant_solver_.SolveWithoutUsingParallelism(); });
+        record.checksum = ant_solver_.GetResult().distance;
+        report.Write(record);
+    }
+    if (options.HasMode("parallel")) {
+        record.mode = "parallel";
+        record.threads = parameters.threads;
+        record.timing = harness.Measure([&] { ant_solver_.SolveUsingParallelism(); });
+        record.checksum = ant_solver_.GetResult().distance;
+        report.Write(record);
+    }
+    return true;
 }
 
-void ConsoleForAnt::ShowData(double time, TsmResult &path) {
-    printf("Time duration: %lf\n", time);
+void ConsoleForAnt::ShowData(const TimingStats &stats, TsmResult &path) {
+    printf("Time duration: %s\n", stats.ToString().c_str());
     printf("Path:\n");
     for (auto iter : path.vertices) {
         printf("%d, ", iter);
@@ -70,8 +193,22 @@ void ConsoleForAnt::ShowData(double time, TsmResult &path) {
 
 void ConsoleForAnt::PrintResult() {
     cout << "Single-thread results:\n";
-    ShowData(duration_without_parallelism_.count(), single_thread_result_);
-    cout << "\nMultithread results\n";
-    ShowData(duration_with_parallelism_.count(), multithread_result_);
+    ShowData(stats_without_parallelism_, single_thread_result_);
+    bool multithread = speedup_curve_.size() > 1;
+    if (multithread) {
+        cout << "\nMultithread results\n";
+        ShowData(stats_with_parallelism_, multithread_result_);
+    } else {
+        cout << "\nMultithread results are skipped: the maximal count of threads is 1\n";
+    }
+    if (ant_solver_.GetParameters().local_search != LocalSearchMode::kNone) {
+        printf("Local search time of all threads: %lf\n", local_search_time_);
+    }
+    cout << (multithread ? "\nSpeedup curve by median times\n"
+                         : "\nSpeedup curve by median times (single point, only one thread measured)\n");
+    for (auto &point : speedup_curve_) {
+        printf("Threads: %3d  Time: %lf  Speedup: %.2lf\n", point.first, point.second,
+               speedup_curve_[0].second / point.second);
+    }
 }
 }  // namespace s21
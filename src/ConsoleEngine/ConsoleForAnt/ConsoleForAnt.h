@@ -2,6 +2,8 @@
 #define PARALLELS_CONSOLEFORANT_H
 
 #include "../../Algorithms/AntColonyAlgorithm/AntAlgorithm.h"
+#include "../../Utils/Timing/TimingHarness.h"
+#include "../../Utils/Tsplib/TsplibLoader.h"
 #include "../AbstractConsoleEngine.h"
 
 namespace s21 {
@@ -13,15 +15,22 @@ private:
     AntAlgorithm ant_solver_;
     TsmResult multithread_result_, single_thread_result_;
 
-    std::chrono::duration<double> duration_without_parallelism_;
-    std::chrono::duration<double> duration_with_parallelism_;
+    int repetitions_ = 1;
+    TimingStats stats_without_parallelism_;
+    TimingStats stats_with_parallelism_;
+    double local_search_time_ = 0.0;
+    // Median time of the solve for 1, 2, 4, ... threads up to the maximal count of threads
+    std::vector<std::pair<int, double>> speedup_curve_;
 
-    void ShowData(double time, TsmResult &path);
+    void ShowData(const TimingStats &stats, TsmResult &path);
     int InputValue(int bottom_border);
     void WrongInputMessage();
     void RequestParamsFromUser();
+    void RequestSolverParams();
+    std::shared_ptr<DistanceProvider> LoadTsplib(std::string path);
     void RunAlgorithm();
     void PrintResult();
+    bool RunBatch(const BatchOptions &options, BatchReport &report);
 };
 }  // namespace s21
 
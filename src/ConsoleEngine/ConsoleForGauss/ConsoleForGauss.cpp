@@ -4,6 +4,8 @@ namespace s21 {
 ConsoleForGauss::ConsoleForGauss() {
     gauss_algorithm_ = new GaussAlgorithm;
     start_message_ = "=== Solution of SLAE by GaussAlgorithm method ===";
+    algorithm_name_ = "gauss";
+    batch_modes_ = {"serial", "parallel"};
 }
 
 ConsoleForGauss::~ConsoleForGauss() { delete gauss_algorithm_; }
@@ -14,22 +16,73 @@ void ConsoleForGauss::PrintResult() {
     cout << "Output using parallelism:" << endl;
     PrintMatrix(results_.second);
     if (!result_without_using_parallelism_.is_empty() && !result_using_parallelism_.is_empty()) {
-        cout << "Seconds spent without using parallelism: ";
-        printf("%.6lf", times_.first);
-        cout << endl << "Seconds spent using parallelism: ";
-        printf("%.6lf", times_.second);
-        cout << endl;
+        cout << "Seconds spent without using parallelism: " << serial_stats_.ToString() << endl;
+        cout << "Seconds spent using parallelism: " << parallel_stats_.ToString() << endl;
     }
 }
 
 void ConsoleForGauss::RunAlgorithm() {
-    times_ = gauss_algorithm_->MeasureTime(matrix_, results_, number_of_repetitions_);
+    // Solvers take the matrix by value: its copy is made before the clock starts and moved in
+    TimingHarness harness(number_of_repetitions_);
+    S21Matrix input;
+    auto copy_input = [&] { input = matrix_; };
+    serial_stats_ = harness.Measure(copy_input, [&] {
+        results_.first = gauss_algorithm_->SolveWithoutUsingParallelism(std::move(input));
+    });
+    parallel_stats_ = harness.Measure(
+        copy_input, [&] { results_.second = gauss_algorithm_->SolveUsingParallelism(std::move(input)); });
     result_without_using_parallelism_ = results_.first;
     result_using_parallelism_ = results_.second;
     number_of_repetitions_ = -1;
     filename_ = "";
 }
 
+bool ConsoleForGauss::RunBatch(const BatchOptions &options, BatchReport &report) {
+    BatchRecord record;
+    record.algorithm = algorithm_name_;
+    record.seed = options.seed;
+    if (!options.inputs.empty()) {
+        std::fstream fs(options.inputs[0], std::fstream::in);
+        S21Matrix* matrix = fs.is_open() ? S21Matrix::ParseFileWithMatrix(fs) : nullptr;
+        if (!matrix || matrix->get_rows() + 1 != matrix->get_cols() || matrix->get_rows() < 2) {
+            std::cerr << "Can't read a system of equations from " << options.inputs[0] << endl;
+            delete matrix;
+            return false;
+        }
+        matrix_ = *matrix;
+        delete matrix;
+        record.input = options.inputs[0];
+    } else {
+        // Diagonal dominance keeps the generated system solvable without pivoting
+        matrix_ = S21Matrix(options.size, options.size + 1);
+        S21Matrix::FillMatrixWithRandValues(&matrix_, options.seed);
+        for (int i = 0; i < options.size; ++i) matrix_(i, i) += 100.0 * options.size;
+        record.input = "generated";
+    }
+    record.rows = matrix_.get_rows();
+    record.cols = matrix_.get_cols();
+
+    TimingHarness harness(options.repetitions, options.warmups);
+    S21Matrix input, result;
+    auto copy_input = [&] { input = matrix_; };
+    if (options.HasMode("serial")) {
+        record.mode = "serial";
+        record.timing = harness.Measure(
+            copy_input, [&] { result = gauss_algorithm_->SolveWithoutUsingParallelism(std::move(input)); });
+        record.checksum = BatchReport::Checksum(result);
+        report.Write(record);
+    }
+    if (options.HasMode("parallel")) {
+        record.mode = "parallel";
+        record.threads = Executor::Instance().get_workers();
+        record.timing = harness.Measure(
+            copy_input, [&] { result = gauss_algorithm_->SolveUsingParallelism(std::move(input)); });
+        record.checksum = BatchReport::Checksum(result);
+        report.Write(record);
+    }
+    return true;
+}
+
 void ConsoleForGauss::RequestParamsFromUser() {
     std::fstream fs = RequestFilenameFromUser();
     S21Matrix* matrix = S21Matrix::ParseFileWithMatrix(fs);
@@ -5,6 +5,7 @@
 #include <string>
 
 #include "../../Algorithms/GaussAlgorithm/GaussAlgorithm.h"
+#include "../../Utils/Timing/TimingHarness.h"
 #include "../AbstractConsoleEngine.h"
 
 using std::cin;
@@ -20,6 +21,7 @@ public:
 protected:
     void RequestParamsFromUser();
     void RunAlgorithm();
+    bool RunBatch(const BatchOptions &options, BatchReport &report);
     std::string filename_ = "";
     S21Matrix result_without_using_parallelism_;
     int number_of_repetitions_ = -1;
@@ -34,7 +36,8 @@ private:
 
     GaussAlgorithm *gauss_algorithm_;
     S21Matrix matrix_;
-    std::pair<double, double> times_;
+    TimingStats serial_stats_;
+    TimingStats parallel_stats_;
     std::pair<S21Matrix, S21Matrix> results_;
 };
 }  // namespace s21
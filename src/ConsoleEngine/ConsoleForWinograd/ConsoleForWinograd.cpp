@@ -8,6 +8,8 @@ ConsoleForWinograd::ConsoleForWinograd() : AbstractConsoleEngine() {
         "Hello. This program allows to test performance in "
         "Winograd matrix multiplication method and "
         "compare multithreading and single thread realisation.\n";
+    algorithm_name_ = "winograd";
+    batch_modes_ = {"serial", "pipeline", "classic", "prepared", "integer"};
 }
 
 ConsoleForWinograd::~ConsoleForWinograd() {
@@ -31,16 +33,21 @@ void ConsoleForWinograd::RequestParamsFromUser() {
 
     cout << "Enter path to file with matrix, "
             "or you can enter integer N M and matrix will be filled randomly: ";
-    while (!GetMatrixInput(&M1_)) {
+    std::future<S21Matrix *> first_loading, second_loading;
+    while (!GetMatrixInput(&first_loading, &left_operand_, WinogradPreparedOperand::Side::kLeft)) {
         rows_ = 0;
         cols_ = 0;
     }
-    cout << "First matrix has been load successfully, specify second matrix: ";
+    cout << "First matrix is loading, specify second matrix: ";
 
-    while (!GetMatrixInput(&M2_)) {
+    while (!GetMatrixInput(&second_loading, &right_operand_, WinogradPreparedOperand::Side::kRight)) {
         rows_ = 0;
         cols_ = 0;
     }
+
+    M1_ = WaitForMatrix(&first_loading, &left_operand_, WinogradPreparedOperand::Side::kLeft);
+    cout << "First matrix has been load successfully." << endl;
+    M2_ = WaitForMatrix(&second_loading, &right_operand_, WinogradPreparedOperand::Side::kRight);
     cout << "Second matrix has been load successfully." << endl;
 
     if (M1_->get_cols() != M2_->get_rows()) {
@@ -73,102 +80,199 @@ void ConsoleForWinograd::RunAlgorithm() {
         S21Matrix::Print_matrix(*M2_);
     }
 
-    auto start = std::chrono::high_resolution_clock::now();
-
-    for (int i = 0; i < nmb_of_repeats_; i++) {
-        if (need_to_print_values_ && i == nmb_of_repeats_ - 1) {
-            result = winograd_algorithm_.SolveWithoutParallelism(M1_, M2_);
-        } else {
-            winograd_algorithm_.SolveWithoutParallelism(M1_, M2_);
+    // Results are printed after the measurement of each method, outside of the time
+    TimingHarness harness(nmb_of_repeats_);
+    auto print_result = [&](const char *method) {
+        if (need_to_print_values_) {
+            cout << "\nResult matrix values from " << method << ": " << endl;
+            S21Matrix::Print_matrix(result);
         }
+    };
+
+    stats_without_parallelism_ =
+        harness.Measure([&] { result = winograd_algorithm_.SolveWithoutParallelism(M1_, M2_); });
+    print_result("method without parallelism");
+
+    stats_with_pipeline_parallelism_ =
+        harness.Measure([&] { result = winograd_algorithm_.SolveWithPipelineParallelism(M1_, M2_); });
+    print_result("method with pipeline parallelism");
+
+    stats_with_classic_parallelism_ = harness.Measure(
+        [&] { result = winograd_algorithm_.SolveWithClassicParallelism(M1_, M2_, nmb_of_threads_); });
+    print_result("method with classic parallelism");
+
+    RefreshPreparedOperands();
+    stats_with_prepared_operands_ = harness.Measure([&] {
+        result =
+            winograd_algorithm_.SolveWithPreparedOperands(left_operand_, right_operand_, nmb_of_threads_);
+    });
+    print_result("method with operands prepared during loading");
+
+    IntegerMatrix<std::int32_t> M1, M2;
+    integer_arithmetic_available_ = IntegerMatrix<std::int32_t>::FromMatrix(*M1_, M1) &&
+                                    IntegerMatrix<std::int32_t>::FromMatrix(*M2_, M2) &&
+                                    IntegerWinogradAlgorithm<std::int64_t>::IsOverflowSafe(M1, M2);
+    if (integer_arithmetic_available_) {
+        IntegerMatrix<std::int64_t> integer_result;
+        stats_with_integer_arithmetic_ = harness.Measure([&] {
+            integer_result = integer_winograd_algorithm_.Solve(M1, M2, nmb_of_threads_);
+        });
+        result = integer_result.ToMatrix();
+        print_result("exact integer method with classic parallelism");
     }
 
-    if (need_to_print_values_) {
-        cout << "\nResult matrix values from method without parallelism: " << endl;
-        S21Matrix::Print_matrix(result);
-    }
-
-    duration_without_parallelism_ = std::chrono::high_resolution_clock::now() - start;
-
-    start = std::chrono::high_resolution_clock::now();
-
-    for (int i = 0; i < nmb_of_repeats_; i++) {
-        if (need_to_print_values_&& i == nmb_of_repeats_ - 1) {
-            result = winograd_algorithm_.SolveWithPipelineParallelism(M1_, M2_);
-        } else {
-            result = winograd_algorithm_.SolveWithPipelineParallelism(M1_, M2_);
-        }
-
-    }
-
-    duration_with_pipeline_parallelism_ = std::chrono::high_resolution_clock::now() - start;
+    cout << "Done" << endl;
+}
 
-    if (need_to_print_values_) {
-        cout << "Result matrix values from method with pipeline parallelism: " << endl;
-        S21Matrix::Print_matrix(result);
+void ConsoleForWinograd::PrintResult() {
+    cout << "Results:" << endl
+         << "Duration without parallelism: " << stats_without_parallelism_.ToString() << endl
+         << "Duration with pipeline parallelism: " << stats_with_pipeline_parallelism_.ToString() << endl
+         << "Duration with classic parallelism: " << stats_with_classic_parallelism_.ToString() << endl
+         << "Duration with operands prepared during loading: " << stats_with_prepared_operands_.ToString()
+         << endl;
+    if (integer_arithmetic_available_) {
+        cout << "Duration with exact integer arithmetic: " << stats_with_integer_arithmetic_.ToString()
+             << endl;
     }
+    cout << endl;
+}
 
-    start = std::chrono::high_resolution_clock::now();
-
-    for (int i = 0; i < nmb_of_repeats_; i++) {
-        if (need_to_print_values_ && i == nmb_of_repeats_ - 1) {
-            result = winograd_algorithm_.SolveWithClassicParallelism(M1_, M2_, nmb_of_threads_);
-        } else {
-            winograd_algorithm_.SolveWithClassicParallelism(M1_, M2_, nmb_of_threads_);
-        }
+bool ConsoleForWinograd::RunBatch(const BatchOptions &options, BatchReport &report) {
+    delete M1_;
+    delete M2_;
+    M1_ = LoadBatchMatrix(options, 0);
+    M2_ = LoadBatchMatrix(options, 1);
+    if (!M1_ || !M2_ || M1_->get_cols() != M2_->get_rows()) {
+        std::cerr << "Can't read two matrices with matching dimensions" << endl;
+        return false;
     }
-
-    duration_with_classic_parallelism_ = std::chrono::high_resolution_clock::now() - start;
-
-    if (need_to_print_values_) {
-        cout << "Result matrix values from method with classic parallelism: " << endl;
-        S21Matrix::Print_matrix(result);
+    left_operand_.Prepare(M1_, WinogradPreparedOperand::Side::kLeft);
+    right_operand_.Prepare(M2_, WinogradPreparedOperand::Side::kRight);
+    nmb_of_threads_ = options.threads > 0 ? options.threads : Executor::Instance().get_workers();
+
+    BatchRecord record;
+    record.algorithm = algorithm_name_;
+    record.input = options.inputs.empty() ? "generated" : options.inputs[0];
+    if (options.inputs.size() > 1) record.input += "," + options.inputs[1];
+    record.rows = M1_->get_rows();
+    record.cols = M2_->get_cols();
+    record.seed = options.seed;
+    TimingHarness harness(options.repetitions, options.warmups);
+    S21Matrix result;
+    auto result_checksum = [&] { return BatchReport::Checksum(result); };
+    auto measure = [&](const string &mode, int threads, auto run, auto checksum) {
+        if (!options.HasMode(mode)) return;
+        record.mode = mode;
+        record.threads = threads;
+        record.timing = harness.Measure(run);
+        record.checksum = checksum();
+        report.Write(record);
+    };
+    auto serial = [&] { result = winograd_algorithm_.SolveWithoutParallelism(M1_, M2_); };
+    auto pipeline = [&] { result = winograd_algorithm_.SolveWithPipelineParallelism(M1_, M2_); };
+    int threads = nmb_of_threads_;
+    auto classic = [&] { result = winograd_algorithm_.SolveWithClassicParallelism(M1_, M2_, threads); };
+    auto prepared = [&] {
+        result = winograd_algorithm_.SolveWithPreparedOperands(left_operand_, right_operand_, threads);
+    };
+    measure("serial", 1, serial, result_checksum);
+    measure("pipeline", 3, pipeline, result_checksum);
+    measure("classic", threads, classic, result_checksum);
+    if (options.HasMode("prepared")) RefreshPreparedOperands();
+    measure("prepared", threads, prepared, result_checksum);
+
+    IntegerMatrix<std::int32_t> M1, M2;
+    bool integer_available = IntegerMatrix<std::int32_t>::FromMatrix(*M1_, M1) &&
+                             IntegerMatrix<std::int32_t>::FromMatrix(*M2_, M2) &&
+                             IntegerWinogradAlgorithm<std::int64_t>::IsOverflowSafe(M1, M2);
+    if (integer_available) {
+        // Conversion of the exact result to doubles is left out of the time
+        IntegerMatrix<std::int64_t> integer_result;
+        auto integer = [&] { integer_result = integer_winograd_algorithm_.Solve(M1, M2, threads); };
+        measure("integer", threads, integer,
+                [&] { return BatchReport::Checksum(integer_result.ToMatrix()); });
+    } else if (options.HasMode("integer")) {
+        std::cerr << "Integer mode is skipped: values are not integers or may overflow" << endl;
     }
+    return true;
+}
 
-    cout << "Done" << endl;
+// The operands are prepared during loading and only read by the other methods, so they are expected
+// to be actual. Otherwise they are prepared here, not inside the time of the prepared method
+void ConsoleForWinograd::RefreshPreparedOperands() {
+    if (left_operand_.IsActual() && right_operand_.IsActual()) return;
+    std::cerr << "Prepared operands are stale, they are prepared again before the measurement" << endl;
+    left_operand_.Refresh();
+    right_operand_.Refresh();
 }
 
-void ConsoleForWinograd::PrintResult() {
-    printf("Results:\n"
-    "Duration without parallelism: %lfs\n"
-    "Duration with pipeline parallelism: %lfs\n"
-    "Duration with classic parallelism: %lfs\n\n", duration_without_parallelism_.count(),
-                                                duration_with_pipeline_parallelism_.count(), 
-                                                duration_with_classic_parallelism_.count());
+S21Matrix *ConsoleForWinograd::LoadBatchMatrix(const BatchOptions &options, int index) {
+    if (options.inputs.empty()) {
+        S21Matrix *mat = new S21Matrix(options.size, options.size);
+        S21Matrix::FillMatrixWithRandValues(mat, options.seed + index);
+        return mat;
+    }
+    // The only input is multiplied by itself
+    fstream file(options.inputs[std::min<size_t>(index, options.inputs.size() - 1)], fstream::in);
+    return file.is_open() ? S21Matrix::ParseFileWithMatrix(file) : nullptr;
 }
 
-bool ConsoleForWinograd::GetMatrixInput(S21Matrix **mat) {
+bool ConsoleForWinograd::GetMatrixInput(std::future<S21Matrix *> *loading, WinogradPreparedOperand *operand,
+                                        WinogradPreparedOperand::Side side) {
     string input;
     std::getline(cin, input);
     char ch;
 
+    // Matrix is parsed and its factors are calculated in background, while the user enters the next one
     if (sscanf(input.data(), "%d%c%d", &rows_, &ch, &cols_) == 3 && ch == ' ') {
         if (rows_ <= 0 || cols_ <= 0) {
             cout << "Invalid number of rows, cols, try again pls: ";
             return false;
         } else {
-            *mat = new S21Matrix(rows_, cols_);
-            S21Matrix::FillMatrixWithRandValues(*mat);
+            // rand() is not thread-safe, so each load gets its own generator
+            int rows = rows_, cols = cols_;
+            std::uint64_t seed = std::random_device()();
+            *loading = std::async(std::launch::async, [rows, cols, seed, operand, side] {
+                S21Matrix *mat = new S21Matrix(rows, cols);
+                S21Matrix::FillMatrixWithRandValues(mat, seed);
+                operand->Prepare(mat, side);
+                return mat;
+            });
         }
     } else {
-        fstream file(input);
-        if (!file) {
+        auto file = std::make_shared<fstream>(input);
+        if (!*file) {
             cout << "Invalid input, you need to enter file name or matrix dimensions(N M). Try again pls: ";
             return false;
         }
-        *mat = S21Matrix::ParseFileWithMatrix(file);
-        file.close();
-        if (*mat == nullptr) {
-            cout << "Error during parsing file, file has worng matrix dimensons or format, try again pls." << endl;
-            cout << "Enter file name or matrix dimensions(N M): "; 
-            return false;
-        }
+        *loading = std::async(std::launch::async, [file, operand, side] {
+            S21Matrix *mat = S21Matrix::ParseFileWithMatrix(*file);
+            file->close();
+            if (mat) operand->Prepare(mat, side);
+            return mat;
+        });
     }
     rows_ = 0;
     cols_ = 0;
     return true;
 }
 
+S21Matrix *ConsoleForWinograd::WaitForMatrix(std::future<S21Matrix *> *loading, WinogradPreparedOperand *operand,
+                                             WinogradPreparedOperand::Side side) {
+    S21Matrix *mat = loading->get();
+    while (mat == nullptr) {
+        cout << "Error during parsing file, file has worng matrix dimensons or format, try again pls." << endl;
+        cout << "Enter file name or matrix dimensions(N M): ";
+        while (!GetMatrixInput(loading, operand, side)) {
+            rows_ = 0;
+            cols_ = 0;
+        }
+        mat = loading->get();
+    }
+    return mat;
+}
+
 int ConsoleForWinograd::RequestNmbFromUser(string message) {
     std::string input;
     cout << message;
@@ -2,13 +2,17 @@
 #ifndef PARALLELS_CONSOLEFORWINOGRAD_H
 #define PARALLELS_CONSOLEFORWINOGRAD_H
 
-#include <chrono>
 #include <cstring>
 #include <fstream>
+#include <future>
 #include <iostream>
+#include <random>
 
+#include "../../Algorithms/WinogradAlgorithm/IntegerWinogradAlgorithm.h"
 #include "../../Algorithms/WinogradAlgorithm/WinogradAlgorithm.h"
+#include "../../Algorithms/WinogradAlgorithm/WinogradPreparedOperand.h"
 #include "../../DataStructures/Matrix/Matrix.h"
+#include "../../Utils/Timing/TimingHarness.h"
 #include "../AbstractConsoleEngine.h"
 
 using std::cin;
@@ -31,24 +35,38 @@ private:
     int rows_;
     int cols_;
 
+    // Factors of the operands are calculated right after each matrix is loaded
+    WinogradPreparedOperand left_operand_;
+    WinogradPreparedOperand right_operand_;
+
     WinogradAlgorithm winograd_algorithm_;
+    IntegerWinogradAlgorithm<std::int64_t> integer_winograd_algorithm_;
     int nmb_of_repeats_;
     int nmb_of_threads_;
 
     bool need_to_print_values_;
 
-    std::chrono::duration<double> duration_without_parallelism_;
-    std::chrono::duration<double> duration_with_pipeline_parallelism_;
-    std::chrono::duration<double> duration_with_classic_parallelism_;
+    TimingStats stats_without_parallelism_;
+    TimingStats stats_with_pipeline_parallelism_;
+    TimingStats stats_with_classic_parallelism_;
+    TimingStats stats_with_integer_arithmetic_;
+    TimingStats stats_with_prepared_operands_;
+    bool integer_arithmetic_available_;
 
     void RequestParamsFromUser();
     void RunAlgorithm();
     void PrintResult();
+    bool RunBatch(const BatchOptions &options, BatchReport &report);
 
     bool AskUserAboutPrintingValues();
-    bool GetMatrixInput(S21Matrix **mat);
+    bool GetMatrixInput(std::future<S21Matrix *> *loading, WinogradPreparedOperand *operand,
+                        WinogradPreparedOperand::Side side);
+    S21Matrix *WaitForMatrix(std::future<S21Matrix *> *loading, WinogradPreparedOperand *operand,
+                             WinogradPreparedOperand::Side side);
     int RequestNmbFromUser(string message);
     S21Matrix *ParseFileWithMatrix(fstream file);
+    S21Matrix *LoadBatchMatrix(const BatchOptions &options, int index);
+    void RefreshPreparedOperands();
 };
 
 }  // namespace s21
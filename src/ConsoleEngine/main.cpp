@@ -1,3 +1,8 @@
+#include <iostream>
+
+#include "../Utils/Executor/Executor.h"
+#include "Batch/BatchOptions.h"
+
 #ifdef ANT
 #include "ConsoleForAnt/ConsoleForAnt.h"
 #endif
@@ -8,7 +13,16 @@
 #include "ConsoleForWinograd/ConsoleForWinograd.h"
 #endif
 
-int main() {
+int main(int argc, char *argv[]) {
+    // Any flag switches the program to the batch mode
+    s21::BatchOptions options;
+    if (argc > 1 && !s21::BatchOptions::Parse(argc, argv, options)) {
+        return 1;
+    }
+    if (options.threads > 0 && !s21::Executor::Configure(options.threads)) {
+        std::cerr << "Threads can't be set: the executor is already running" << std::endl;
+        return 1;
+    }
     s21::AbstractConsoleEngine *console;
 #ifdef ANT
     console = new s21::ConsoleForAnt;
@@ -19,7 +33,12 @@ int main() {
 #ifdef WINOGRAD
     console = new s21::ConsoleForWinograd;
 #endif
-    console->start();
+    int code = 0;
+    if (argc > 1) {
+        code = console->StartBatch(options);
+    } else {
+        console->start();
+    }
     delete console;
-    return 0;
+    return code;
 }
@@ -0,0 +1,89 @@
+#include "DistanceProvider.h"
+
+namespace s21 {
+namespace {
+const double kPi = 3.141592;
+const double kEarthRadius = 6378.388;
+
+// Degrees.minutes of TSPLIB GEO format to radians
+double ToRadians(double value) {
+    int degrees = (int)value;
+    return kPi * (degrees + 5.0 * (value - degrees) / 3.0) / 180.0;
+}
+}  // namespace
+
+MatrixDistances::MatrixDistances(S21Matrix matrix) : matrix_(std::move(matrix)), symmetric_(true) {
+    for (int i = 0; i < matrix_.get_rows() && symmetric_; ++i) {
+        for (int j = 0; j < i; ++j) {
+            if (matrix_(i, j) != matrix_(j, i)) {
+                symmetric_ = false;
+                break;
+            }
+        }
+    }
+}
+
+int MatrixDistances::get_size() const { return matrix_.get_rows(); }
+
+double MatrixDistances::Distance(int from, int to) const { return matrix_(from, to); }
+
+bool MatrixDistances::is_symmetric() const { return symmetric_; }
+
+void MatrixDistances::SetDistance(int from, int to, double distance) {
+    matrix_(from, to) = distance;
+    symmetric_ = symmetric_ && matrix_(to, from) == distance;
+}
+
+CoordinateDistances::CoordinateDistances(std::vector<double> x, std::vector<double> y, EdgeWeightType type)
+    : x_(std::move(x)), y_(std::move(y)), type_(type) {
+    if (type_ == EdgeWeightType::kGeographical) {
+        for (size_t i = 0; i < x_.size(); ++i) {
+            x_[i] = ToRadians(x_[i]);
+            y_[i] = ToRadians(y_[i]);
+        }
+    }
+}
+
+int CoordinateDistances::get_size() const { return x_.size(); }
+
+bool CoordinateDistances::is_metric() const { return true; }
+
+bool CoordinateDistances::is_symmetric() const { return true; }
+
+double CoordinateDistances::Distance(int from, int to) const { return Calculate(from, to); }
+
+double CoordinateDistances::CandidateDistance(int from, int slot, int to) const {
+    if (slot < cached_count_) {
+        return cached_distances_[(size_t)from * cached_count_ + slot];
+    }
+    return Calculate(from, to);
+}
+
+void CoordinateDistances::CacheEdges(const std::vector<int> &candidates, int count) {
+    cached_count_ = 0;
+    cached_distances_.resize(candidates.size());
+    for (size_t i = 0; i < candidates.size(); ++i) {
+        cached_distances_[i] = Calculate(i / count, candidates[i]);
+    }
+    cached_count_ = count;
+}
+
+double CoordinateDistances::Calculate(int from, int to) const {
+    if (from == to) {
+        return 0.0;
+    }
+    double dx = x_[from] - x_[to], dy = y_[from] - y_[to];
+    if (type_ == EdgeWeightType::kEuclidean) {
+        return std::nearbyint(std::sqrt(dx * dx + dy * dy));
+    } else if (type_ == EdgeWeightType::kPseudoEuclidean) {
+        double r = std::sqrt((dx * dx + dy * dy) / 10.0);
+        double t = std::nearbyint(r);
+        return t < r ? t + 1.0 : t;
+    }
+    // x holds latitude and y holds longitude
+    double q1 = std::cos(y_[from] - y_[to]);
+    double q2 = std::cos(x_[from] - x_[to]);
+    double q3 = std::cos(x_[from] + x_[to]);
+    return (int)(kEarthRadius * std::acos(0.5 * ((1.0 + q1) * q2 - (1.0 - q1) * q3)) + 1.0);
+}
+}  // namespace s21
@@ -0,0 +1,78 @@
+#ifndef PARALLELS_DISTANCEPROVIDER_H
+#define PARALLELS_DISTANCEPROVIDER_H
+
+#include <vector>
+
+#include "../Matrix/Matrix.h"
+
+namespace s21 {
+
+// Distances between the nodes of a complete graph, so that a solver does not need a dense matrix
+class DistanceProvider {
+public:
+    virtual ~DistanceProvider() = default;
+
+    virtual int get_size() const = 0;
+    virtual double Distance(int from, int to) const = 0;
+    // Direct edge is always the shortest way between two nodes
+    virtual bool is_metric() const { return false; }
+    // Distance from i to j is the distance from j to i
+    virtual bool is_symmetric() const { return false; }
+    // Graphs given by coordinates can't change a single edge
+    virtual void SetDistance(int from, int to, double distance) {
+        (void)from;
+        (void)to;
+        (void)distance;
+        throw "Distance provider error: edges of the graph can't be changed";
+    }
+    // Row i of candidates holds count nodes whose distances from i are asked most often
+    virtual void CacheEdges(const std::vector<int> &candidates, int count) {
+        (void)candidates;
+        (void)count;
+    }
+    // Distance to the node at position slot of the row of candidates given to CacheEdges
+    virtual double CandidateDistance(int from, int slot, int to) const {
+        (void)slot;
+        return Distance(from, to);
+    }
+};
+
+class MatrixDistances : public DistanceProvider {
+public:
+    explicit MatrixDistances(S21Matrix matrix);
+
+    int get_size() const override;
+    double Distance(int from, int to) const override;
+    bool is_symmetric() const override;
+    void SetDistance(int from, int to, double distance) override;
+
+private:
+    S21Matrix matrix_;
+    bool symmetric_;
+};
+
+enum class EdgeWeightType { kEuclidean, kGeographical, kPseudoEuclidean };
+
+// Distances of TSPLIB EUC_2D, GEO and ATT instances, computed from coordinates on demand
+class CoordinateDistances : public DistanceProvider {
+public:
+    CoordinateDistances(std::vector<double> x, std::vector<double> y, EdgeWeightType type);
+
+    int get_size() const override;
+    double Distance(int from, int to) const override;
+    bool is_metric() const override;
+    bool is_symmetric() const override;
+    void CacheEdges(const std::vector<int> &candidates, int count) override;
+    double CandidateDistance(int from, int slot, int to) const override;
+
+private:
+    std::vector<double> x_, y_;
+    EdgeWeightType type_;
+    std::vector<double> cached_distances_;
+    int cached_count_ = 0;
+
+    double Calculate(int from, int to) const;
+};
+}  // namespace s21
+
+#endif  // PARALLELS_DISTANCEPROVIDER_H
@@ -0,0 +1,125 @@
+#ifndef PARALLELS_EDGEMATRIX_H
+#define PARALLELS_EDGEMATRIX_H
+
+#include <cmath>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <vector>
+
+namespace s21 {
+
+// kDense keeps a double for every directed edge. kSymmetric keeps one float for both directions of an
+// edge in a lower triangle without the diagonal. kCandidates keeps floats only for the edges to
+// candidate nodes, all other edges share the background value.
+enum class EdgeStorage { kDense, kSymmetric, kCandidates };
+
+// Values on the edges of a graph. Values are grouped in rows: updates of different rows never touch
+// the same value, so rows can be updated in parallel.
+class EdgeMatrix {
+public:
+    double background = 0.0;
+
+    EdgeMatrix() = default;
+    // candidates must outlive the matrix, row i holds candidates_count nodes
+    EdgeMatrix(EdgeStorage storage, int size, const std::vector<int> &candidates, int candidates_count)
+        : storage_(storage), size_(size), candidates_(&candidates), candidates_count_(candidates_count) {
+        if (storage_ == EdgeStorage::kCandidates && candidates_count_ == 0) {
+            storage_ = EdgeStorage::kDense;
+        }
+        if (storage_ == EdgeStorage::kDense) {
+            dense_.assign((size_t)size_ * size_, 0.0);
+        } else {
+            compact_.assign(RowBegin(size_), 0.0f);
+        }
+    }
+
+    EdgeStorage get_storage() const { return storage_; }
+    int get_size() const { return size_; }
+    std::int64_t get_count() const { return RowBegin(size_); }
+    bool stores_all_edges() const { return storage_ != EdgeStorage::kCandidates; }
+
+    // Index of the value of the edge or -1 if the edge has the background value
+    std::int64_t Index(int from, int to) const {
+        if (storage_ == EdgeStorage::kDense) {
+            return (std::int64_t)from * size_ + to;
+        } else if (storage_ == EdgeStorage::kSymmetric) {
+            if (from == to) return -1;
+            return from > to ? RowBegin(from) + to : RowBegin(to) + from;
+        }
+        const int *candidates = &(*candidates_)[(size_t)from * candidates_count_];
+        for (int k = 0; k < candidates_count_; ++k) {
+            if (candidates[k] == to) return RowBegin(from) + k;
+        }
+        return -1;
+    }
+    // Same as Index for the edge to the candidate at the position of the candidate list of from
+    std::int64_t CandidateIndex(int from, int position, int to) const {
+        return storage_ == EdgeStorage::kCandidates ? RowBegin(from) + position : Index(from, to);
+    }
+    int Row(int from, int to) const {
+        return storage_ == EdgeStorage::kSymmetric && to > from ? to : from;
+    }
+    std::int64_t RowBegin(int row) const {
+        if (storage_ == EdgeStorage::kDense) return (std::int64_t)row * size_;
+        if (storage_ == EdgeStorage::kSymmetric) return (std::int64_t)row * (row - 1) / 2;
+        return (std::int64_t)row * candidates_count_;
+    }
+    std::int64_t RowEnd(int row) const { return RowBegin(row + 1); }
+    // Node at the other end of the edge stored at the index of the row
+    int Column(int row, std::int64_t index) const {
+        return storage_ == EdgeStorage::kCandidates ? (*candidates_)[index] : index - RowBegin(row);
+    }
+    // First row of the part when rows are split into parts with equal count of values
+    int RowSplit(int part, int parts) const {
+        if (storage_ == EdgeStorage::kSymmetric) {
+            return part == parts ? size_ : (int)(size_ * std::sqrt((double)part / parts));
+        }
+        return (std::int64_t)part * size_ / parts;
+    }
+
+    double operator[](std::int64_t index) const {
+        return storage_ == EdgeStorage::kDense ? dense_[index] : compact_[index];
+    }
+    void Set(std::int64_t index, double value) {
+        if (storage_ == EdgeStorage::kDense) {
+            dense_[index] = value;
+        } else {
+            compact_[index] = (float)value;
+        }
+    }
+    double Get(int from, int to) const {
+        std::int64_t index = Index(from, to);
+        return index == -1 ? background : (*this)[index];
+    }
+
+    // Raw values in the layout of the matrix, Load expects a matrix of the same layout
+    void Save(std::ostream &out) const {
+        out.write(reinterpret_cast<const char *>(&background), sizeof(background));
+        if (storage_ == EdgeStorage::kDense) {
+            out.write(reinterpret_cast<const char *>(dense_.data()), dense_.size() * sizeof(double));
+        } else {
+            out.write(reinterpret_cast<const char *>(compact_.data()), compact_.size() * sizeof(float));
+        }
+    }
+    bool Load(std::istream &in) {
+        in.read(reinterpret_cast<char *>(&background), sizeof(background));
+        if (storage_ == EdgeStorage::kDense) {
+            in.read(reinterpret_cast<char *>(dense_.data()), dense_.size() * sizeof(double));
+        } else {
+            in.read(reinterpret_cast<char *>(compact_.data()), compact_.size() * sizeof(float));
+        }
+        return (bool)in;
+    }
+
+private:
+    EdgeStorage storage_ = EdgeStorage::kDense;
+    int size_ = 0;
+    const std::vector<int> *candidates_ = nullptr;
+    int candidates_count_ = 0;
+    std::vector<double> dense_;
+    std::vector<float> compact_;
+};
+}  // namespace s21
+
+#endif  // PARALLELS_EDGEMATRIX_H
@@ -0,0 +1,63 @@
+#ifndef PARALLELS_INTEGERMATRIX_H
+#define PARALLELS_INTEGERMATRIX_H
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "../Matrix/Matrix.h"
+
+namespace s21 {
+
+// Dense row-major matrix of integers used by exact multiplication
+template <typename T>
+class IntegerMatrix {
+public:
+    IntegerMatrix() : rows_(0), cols_(0) {}
+    IntegerMatrix(int rows, int cols) : rows_(rows), cols_(cols), values_((size_t)rows * cols, 0) {}
+
+    int get_rows() const { return rows_; }
+    int get_cols() const { return cols_; }
+    bool is_empty() const { return !rows_ || !cols_; }
+
+    T &operator()(int i, int j) { return values_[(size_t)i * cols_ + j]; }
+    const T &operator()(int i, int j) const { return values_[(size_t)i * cols_ + j]; }
+
+    bool operator==(const IntegerMatrix &other) const {
+        return rows_ == other.rows_ && cols_ == other.cols_ && values_ == other.values_;
+    }
+
+    // Fails if some value of the matrix is not an integer or does not fit into T
+    static bool FromMatrix(const S21Matrix &matrix, IntegerMatrix &result) {
+        result = IntegerMatrix(matrix.get_rows(), matrix.get_cols());
+        for (int i = 0; i < matrix.get_rows(); i++) {
+            for (int j = 0; j < matrix.get_cols(); j++) {
+                double value = matrix(i, j);
+                if (std::floor(value) != value || value < (double)std::numeric_limits<T>::min() ||
+                    value > (double)std::numeric_limits<T>::max()) {
+                    result = IntegerMatrix();
+                    return false;
+                }
+                result(i, j) = (T)value;
+            }
+        }
+        return true;
+    }
+
+    S21Matrix ToMatrix() const {
+        S21Matrix result(rows_, cols_);
+        for (int i = 0; i < rows_; i++) {
+            for (int j = 0; j < cols_; j++) result(i, j) = (double)(*this)(i, j);
+        }
+        return result;
+    }
+
+private:
+    int rows_, cols_;
+    std::vector<T> values_;
+};
+
+}  // namespace s21
+
+#endif  // PARALLELS_INTEGERMATRIX_H
@@ -1,8 +1,19 @@
 #include "Matrix.h"
 
+#include <random>
+#include <utility>
+
 namespace s21 {
 
+std::atomic<std::uint64_t> S21Matrix::_version_counter(0);
+
+void S21Matrix::mark_modified() {
+    _version = ++_version_counter;
+    _dirty = false;
+}
+
 void S21Matrix::destroy_matrix() {
+    mark_modified();
     if (_matrix) {
         for (int i = 0; i < _rows; i++) delete[] _matrix[i];
         delete[] _matrix;
@@ -13,6 +24,7 @@ void S21Matrix::destroy_matrix() {
 }
 
 void S21Matrix::FillWithDigit(const double digit) {
+    mark_modified();
     for (int i = 0; i < _rows; i++) {
         for (int j = 0; j < _cols; j++) {
             _matrix[i][j] = digit;
@@ -22,6 +34,7 @@ void S21Matrix::FillWithDigit(const double digit) {
 
 void S21Matrix::allocate_matrix(int rows, int cols) {
     // if (rows <= 0 || cols <= 0) throw "Matrix creation error: Rows and columns must be greater than zero";
+    mark_modified();
     _rows = rows;
     _cols = cols;
     _matrix = new double *[_rows];
@@ -34,6 +47,7 @@ void S21Matrix::copy_matrix_elements(const S21Matrix &other) {
 }
 
 S21Matrix::S21Matrix() {
+    mark_modified();
     _rows = 0;
     _cols = 0;
     _matrix = nullptr;
@@ -46,12 +60,7 @@ S21Matrix::S21Matrix(const S21Matrix &other) {
     copy_matrix_elements(other);
 }
 
-S21Matrix::S21Matrix(S21Matrix &&other) {
-    if (this == &other) throw "Error: trying to move from the same matrix";
-    allocate_matrix(other._rows, other._cols);
-    copy_matrix_elements(other);
-    other.destroy_matrix();
-}
+S21Matrix::S21Matrix(S21Matrix &&other) : _matrix(nullptr) { *this = std::move(other); }
 
 S21Matrix::~S21Matrix() { destroy_matrix(); }
 
@@ -68,18 +77,21 @@ bool S21Matrix::eq_matrix(const S21Matrix &other) const {
 void S21Matrix::sum_matrix(const S21Matrix &other) {
     if (_rows != other._rows || _cols != other._cols)
         throw "Sum error: dimensions of the matrices must be the same";
+    mark_modified();
     for (int i = 0; i < _rows; i++)
-        for (int j = 0; j < _cols; j++) (*this)(i, j) += other._matrix[i][j];
+        for (int j = 0; j < _cols; j++) _matrix[i][j] += other._matrix[i][j];
 }
 
 void S21Matrix::sub_matrix(const S21Matrix &other) {
     if (_rows != other._rows || _cols != other._cols)
         throw "Sub error: dimensions of the matrices must be the same";
+    mark_modified();
     for (int i = 0; i < _rows; i++)
         for (int j = 0; j < _cols; j++) _matrix[i][j] -= other._matrix[i][j];
 }
 
 void S21Matrix::mul_number(const double num) {
+    mark_modified();
     for (int i = 0; i < _rows; i++)
         for (int j = 0; j < _cols; j++) _matrix[i][j] *= num;
 }
@@ -133,6 +145,19 @@ S21Matrix &S21Matrix::operator=(const S21Matrix &other) {
     return *this;
 }
 
+// Rows are taken over without copying, the other matrix is left empty
+S21Matrix &S21Matrix::operator=(S21Matrix &&other) {
+    if (this != &other) {
+        destroy_matrix();
+        _rows = other._rows;
+        _cols = other._cols;
+        _matrix = other._matrix;
+        other._matrix = nullptr;
+        other.destroy_matrix();
+    }
+    return *this;
+}
+
 void S21Matrix::operator+=(const S21Matrix &other) { sum_matrix(other); }
 
 void S21Matrix::operator-=(const S21Matrix &other) { sub_matrix(other); }
@@ -144,12 +169,23 @@ double &S21Matrix::operator()(const int i, const int j) {
     //        printf("Out of bounds i = %d, j = %d\n", i, j);
     //        exit(1);
     //    }
+    _dirty = true;
     return _matrix[i][j];
 }
 
-int S21Matrix::get_rows() { return _rows; }
+const double &S21Matrix::operator()(const int i, const int j) const { return _matrix[i][j]; }
+
+int S21Matrix::get_rows() const { return _rows; }
+
+int S21Matrix::get_cols() const { return _cols; }
 
-int S21Matrix::get_cols() { return _cols; }
+std::uint64_t S21Matrix::get_version() const {
+    if (_dirty) {
+        _version = ++_version_counter;
+        _dirty = false;
+    }
+    return _version;
+}
 
 void S21Matrix::set_rows(int new_rows) {
     if (new_rows <= 0) throw "Set rows error: rows must be greater than 0";
@@ -167,7 +203,7 @@ void S21Matrix::set_columns(int new_cols) {
 
 bool S21Matrix::is_empty() { return !get_rows() && !get_cols(); }
 
-void S21Matrix::Print_matrix(s21::S21Matrix &m1) {
+void S21Matrix::Print_matrix(const s21::S21Matrix &m1) {
     for (int i = 0; i < m1.get_rows(); i++) {
         for (int j = 0; j < m1.get_cols(); j++) {
             printf("%3.1lf ", m1(i, j));
@@ -183,6 +219,18 @@ void S21Matrix::FillMatrixWithRandValues(s21::S21Matrix *m) {
             m->operator()(i, j) = rand() % 100;
         }
     }
+    m->mark_modified();
+}
+
+void S21Matrix::FillMatrixWithRandValues(s21::S21Matrix *m, std::uint64_t seed) {
+    std::mt19937_64 generator(seed);
+    std::uniform_int_distribution<int> distribution(0, 99);
+    for (int i = 0; i < m->get_rows(); i++) {
+        for (int j = 0; j < m->get_cols(); j++) {
+            m->operator()(i, j) = distribution(generator);
+        }
+    }
+    m->mark_modified();
 }
 
 s21::S21Matrix *S21Matrix::ParseFileWithMatrix(std::fstream &file) {
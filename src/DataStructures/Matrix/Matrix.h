@@ -1,7 +1,9 @@
 #ifndef A2_SIMPLENAVIGATOR_V1_0_0_MASTER_S21_MATRIX_OOP_H
 #define A2_SIMPLENAVIGATOR_V1_0_0_MASTER_S21_MATRIX_OOP_H
 
+#include <atomic>
 #include <cmath>
+#include <cstdint>
 #include <cstdio>
 #include <fstream>
 
@@ -14,6 +16,14 @@ private:
     int _rows, _cols;
     double **_matrix;
 
+    // Version is taken from a process-wide counter so that it never repeats, even for a matrix
+    // created at the address of a destroyed one. Mutators bump it. Non-const element access only sets
+    // the dirty flag, which get_version() turns into a new version, so the access stays cheap.
+    mutable std::uint64_t _version;
+    mutable bool _dirty;
+    static std::atomic<std::uint64_t> _version_counter;
+
+    void mark_modified();
     void destroy_matrix();
     void allocate_matrix(int rows, int cols);
     void copy_matrix_elements(const S21Matrix &other);
@@ -25,12 +35,15 @@ public:
     S21Matrix(S21Matrix &&other);
     ~S21Matrix();
 
-    static void Print_matrix(s21::S21Matrix &m1);
+    static void Print_matrix(const s21::S21Matrix &m1);
     static void FillMatrixWithRandValues(s21::S21Matrix *m);
+    // Same range of values, but the same seed always gives the same matrix
+    static void FillMatrixWithRandValues(s21::S21Matrix *m, std::uint64_t seed);
     static S21Matrix *ParseFileWithMatrix(std::fstream &file);
 
-    int get_rows();
-    int get_cols();
+    int get_rows() const;
+    int get_cols() const;
+    std::uint64_t get_version() const;
 
     void set_rows(int new_rows);
     void set_columns(int new_cols);
@@ -49,10 +62,12 @@ public:
     S21Matrix operator*(const S21Matrix &other);
     bool operator==(const S21Matrix &other) const;
     S21Matrix &operator=(const S21Matrix &other);
+    S21Matrix &operator=(S21Matrix &&other);
     void operator+=(const S21Matrix &other);
     void operator-=(const S21Matrix &other);
     void operator*=(const S21Matrix &other);
     double &operator()(const int i, const int j);
+    const double &operator()(const int i, const int j) const;
 
     bool is_empty();
 };
@@ -1,11 +1,27 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <future>
+#include <limits>
+#include <random>
+#include <set>
+#include <sstream>
 #include <string>
 
 #include "../Algorithms/AntColonyAlgorithm/AntAlgorithm.h"
 #include "../Algorithms/GaussAlgorithm/GaussAlgorithm.h"
+#include "../Algorithms/WinogradAlgorithm/AsyncWinograd.h"
+#include "../Algorithms/WinogradAlgorithm/IntegerWinogradAlgorithm.h"
+#include "../Algorithms/WinogradAlgorithm/MatrixChain.h"
 #include "../Algorithms/WinogradAlgorithm/WinogradAlgorithm.h"
+#include "../ConsoleEngine/Batch/BatchOptions.h"
+#include "../ConsoleEngine/Batch/BatchReport.h"
 #include "../ConsoleEngine/ConsoleForGauss/ConsoleForTestingGauss/ConsoleForTestingGauss.h"
+#include "../Utils/Executor/Executor.h"
+#include "../Utils/Timing/TimingHarness.h"
+#include "../Utils/Tsplib/TsplibLoader.h"
 
 TEST(AntAlgorithmTests, Test1) {
     s21::S21Matrix matrix1(10, 10);
@@ -49,6 +65,647 @@ TEST(AntAlgorithmTests, Test3) {
     EXPECT_TRUE(default_algo.distance == threading_algo.distance);
 }
 
+TEST(AntAlgorithmTests, TourVisitsAllNodes) {
+    const int nodes = 30;
+    s21::S21Matrix matrix(nodes, nodes);
+    s21::S21Matrix::FillMatrixWithRandValues(&matrix);
+    s21::AntAlgorithm ant_solver;
+    ant_solver.SetData(matrix, 3);
+
+    ant_solver.SolveWithoutUsingParallelism();
+    s21::TsmResult result = ant_solver.GetResult();
+    ASSERT_GT((int)result.vertices.size(), nodes);
+    std::vector<int> tour(result.vertices.begin(), result.vertices.begin() + nodes);
+    std::sort(tour.begin(), tour.end());
+    for (int i = 0; i < nodes; i++) EXPECT_EQ(tour[i], i + 1);
+    EXPECT_EQ(result.vertices.front(), 1);
+    EXPECT_EQ(result.vertices.back(), 1);
+}
+
+TEST(AntAlgorithmTests, SameSeedSameTour) {
+    s21::S21Matrix matrix(25, 25);
+    s21::S21Matrix::FillMatrixWithRandValues(&matrix);
+    s21::AntAlgorithm ant_solver;
+    ant_solver.SetData(matrix, 4);
+    ant_solver.SetSeed(2024);
+
+    ant_solver.SolveWithoutUsingParallelism();
+    s21::TsmResult first = ant_solver.GetResult();
+    ant_solver.SolveWithoutUsingParallelism();
+    s21::TsmResult second = ant_solver.GetResult();
+    ant_solver.SolveUsingParallelism();
+    s21::TsmResult threading = ant_solver.GetResult();
+    EXPECT_EQ(first.vertices, second.vertices);
+    EXPECT_EQ(first.distance, second.distance);
+    EXPECT_EQ(first.vertices, threading.vertices);
+}
+
+TEST(AntAlgorithmTests, ParametersAndThreadCount) {
+    s21::S21Matrix matrix(20, 20);
+    s21::S21Matrix::FillMatrixWithRandValues(&matrix);
+    s21::AntAlgorithm ant_solver;
+    ant_solver.SetData(matrix, 3);
+    s21::AntParameters parameters;
+    parameters.ants = 100;
+    parameters.evaporation = 0.3;
+    parameters.Q = 5.0;
+    parameters.beta = 2.0;
+    ant_solver.SetParameters(parameters);
+
+    ant_solver.SolveUsingThreads(1);
+    s21::TsmResult single = ant_solver.GetResult();
+    ant_solver.SolveUsingThreads(3);
+    s21::TsmResult three = ant_solver.GetResult();
+    ant_solver.SolveUsingThreads(8);
+    EXPECT_EQ(single.vertices, three.vertices);
+    EXPECT_EQ(single.vertices, ant_solver.GetResult().vertices);
+
+    parameters.ants = 0;
+    EXPECT_ANY_THROW(ant_solver.SetParameters(parameters));
+    parameters.ants = 10;
+    parameters.evaporation = 1.5;
+    EXPECT_ANY_THROW(ant_solver.SetParameters(parameters));
+}
+
+TEST(AntAlgorithmTests, ReturnsHomeByShortestPath) {
+    s21::S21Matrix matrix(3, 3);
+    matrix(0, 1) = matrix(1, 0) = matrix(1, 2) = matrix(2, 1) = 1;
+    matrix(0, 2) = matrix(2, 0) = 50;
+    s21::AntAlgorithm ant_solver;
+    ant_solver.SetData(matrix, 2);
+
+    ant_solver.SolveWithoutUsingParallelism();
+    s21::TsmResult result = ant_solver.GetResult();
+    EXPECT_EQ(result.distance, 4);
+    EXPECT_EQ(result.vertices, std::vector<int>({1, 2, 3, 2, 1}));
+
+    // Above the limit the direct edges are used
+    s21::AntParameters parameters = ant_solver.GetParameters();
+    parameters.shortest_paths_max_nodes = 2;
+    ant_solver.SetParameters(parameters);
+    ant_solver.SetData(matrix, 2);
+    ant_solver.SolveWithoutUsingParallelism();
+    EXPECT_EQ(ant_solver.GetResult().distance, 52);
+
+    // Missing edges are filled in the copy of the solver, not in the given matrix
+    matrix(0, 2) = matrix(2, 0) = 0;
+    s21::S21Matrix given(matrix);
+    ant_solver.SetData(matrix, 2);
+    EXPECT_TRUE(matrix == given);
+}
+
+TEST(AntAlgorithmTests, CandidateLists) {
+    const int nodes = 60;
+    s21::S21Matrix matrix(nodes, nodes);
+    s21::S21Matrix::FillMatrixWithRandValues(&matrix);
+    s21::AntAlgorithm ant_solver;
+    ant_solver.SetData(matrix, 3);
+    s21::AntParameters parameters = ant_solver.GetParameters();
+    parameters.ants = 50;
+    parameters.candidates = 5;
+    ant_solver.SetParameters(parameters);
+
+    ant_solver.SolveUsingThreads(2);
+    s21::TsmResult result = ant_solver.GetResult();
+    ASSERT_GT((int)result.vertices.size(), nodes);
+    std::vector<int> tour(result.vertices.begin(), result.vertices.begin() + nodes);
+    std::sort(tour.begin(), tour.end());
+    for (int i = 0; i < nodes; i++) EXPECT_EQ(tour[i], i + 1);
+    EXPECT_EQ(result.vertices.back(), 1);
+}
+
+TEST(AntAlgorithmTests, LocalSearchImprovesTour) {
+    const int nodes = 40;
+    s21::S21Matrix matrix(nodes, nodes);
+    s21::S21Matrix::FillMatrixWithRandValues(&matrix);
+    std::vector<int> tour(nodes), candidates;
+    for (int i = 0; i < nodes; i++) tour[i] = i;
+    auto length = [&](const std::vector<int> &path) {
+        double sum = matrix(path.back(), path[0]);
+        for (int i = 1; i < nodes; i++) sum += matrix(path[i - 1], path[i]);
+        return sum;
+    };
+    double before = length(tour);
+    s21::MatrixDistances graph(matrix);
+    std::vector<double> home(nodes);
+    for (int i = 0; i < nodes; i++) home[i] = matrix(i, 0);
+    s21::LocalSearch local_search(graph, home, candidates, 0);
+    double after = local_search.Improve(tour);
+
+    EXPECT_LT(after, before);
+    EXPECT_DOUBLE_EQ(after, length(tour));
+    EXPECT_EQ(tour[0], 0);
+    std::vector<int> sorted = tour;
+    std::sort(sorted.begin(), sorted.end());
+    for (int i = 0; i < nodes; i++) EXPECT_EQ(sorted[i], i);
+
+    s21::AntAlgorithm ant_solver;
+    ant_solver.SetData(matrix, 2);
+    s21::AntParameters parameters = ant_solver.GetParameters();
+    parameters.ants = 32;
+    parameters.local_search = s21::LocalSearchMode::kIterationBest;
+    ant_solver.SetParameters(parameters);
+    ant_solver.SolveUsingThreads(2);
+    EXPECT_GT(ant_solver.GetLocalSearchTime(), 0.0);
+    EXPECT_GT((int)ant_solver.GetResult().vertices.size(), nodes);
+    EXPECT_EQ(ant_solver.GetResult().vertices.back(), 1);
+}
+
+TEST(AntAlgorithmTests, MaxMinAndColonySystems) {
+    const int nodes = 40;
+    s21::S21Matrix matrix(nodes, nodes);
+    s21::S21Matrix::FillMatrixWithRandValues(&matrix);
+    s21::AntAlgorithm ant_solver;
+    ant_solver.SetData(matrix, 5);
+    s21::AntParameters parameters = ant_solver.GetParameters();
+    parameters.ants = 40;
+    parameters.stagnation_iterations = 2;
+    for (auto system : {s21::AntSystem::kMaxMin, s21::AntSystem::kColonySystem}) {
+        parameters.system = system;
+        ant_solver.SetParameters(parameters);
+        ant_solver.SolveUsingThreads(1);
+        s21::TsmResult single = ant_solver.GetResult();
+        ant_solver.SolveUsingThreads(3);
+        EXPECT_EQ(single.vertices, ant_solver.GetResult().vertices);
+        std::vector<int> tour(single.vertices.begin(), single.vertices.begin() + nodes);
+        std::sort(tour.begin(), tour.end());
+        for (int i = 0; i < nodes; i++) EXPECT_EQ(tour[i], i + 1);
+    }
+    parameters.system = s21::AntSystem::kMaxMin;
+    parameters.evaporation = 0.0;
+    EXPECT_ANY_THROW(ant_solver.SetParameters(parameters));
+}
+
+TEST(AntAlgorithmTests, MaxMinBounds) {
+    const int nodes = 30;
+    s21::S21Matrix matrix(nodes, nodes);
+    s21::S21Matrix::FillMatrixWithRandValues(&matrix, 7);
+    s21::AntAlgorithm ant_solver;
+    ant_solver.SetData(matrix, 10);
+    s21::AntParameters parameters = ant_solver.GetParameters();
+    parameters.ants = 20;
+    parameters.system = s21::AntSystem::kMaxMin;
+    ant_solver.SetParameters(parameters);
+    ant_solver.SolveWithoutUsingParallelism();
+
+    double tau_max = parameters.Q / (parameters.evaporation * ant_solver.GetResult().distance);
+    double tau_min = tau_max / (2.0 * nodes);
+    const s21::EdgeMatrix &pheromones = ant_solver.GetPheromones();
+    EXPECT_GE(pheromones.background, tau_min * (1 - 1e-9));
+    EXPECT_LE(pheromones.background, tau_max * (1 + 1e-9));
+    for (int i = 0; i < nodes; ++i) {
+        for (int j = 0; j < nodes; ++j) {
+            if (i == j) continue;
+            EXPECT_GE(pheromones.Get(i, j), tau_min * (1 - 1e-9));
+            EXPECT_LE(pheromones.Get(i, j), tau_max * (1 + 1e-9));
+        }
+    }
+}
+
+TEST(AntAlgorithmTests, ColonySystemRules) {
+    const int nodes = 25;
+    std::mt19937_64 generator(5);
+    std::uniform_real_distribution<double> distribution(1.0, 100.0);
+    s21::S21Matrix matrix(nodes, nodes);
+    for (int i = 0; i < nodes; ++i) {
+        for (int j = 0; j < i; ++j) matrix(i, j) = matrix(j, i) = distribution(generator);
+    }
+    s21::AntAlgorithm ant_solver;
+    ant_solver.SetData(matrix, 1);
+    s21::AntParameters parameters = ant_solver.GetParameters();
+    parameters.ants = 1;
+    parameters.system = s21::AntSystem::kColonySystem;
+    parameters.exploitation = 1.0;
+    ant_solver.SetParameters(parameters);
+    ant_solver.SolveWithoutUsingParallelism();
+
+    // Best edge is always taken and pheromones are equal at the start: the nearest neighbour tour
+    std::vector<int> expected = {1};
+    std::vector<char> visited(nodes);
+    visited[0] = 1;
+    for (int step = 1, cur = 0; step < nodes; ++step) {
+        int next = -1;
+        for (int j = 0; j < nodes; ++j) {
+            if (!visited[j] && (next == -1 || matrix(cur, j) < matrix(cur, next))) next = j;
+        }
+        visited[next] = 1;
+        expected.push_back(next + 1);
+        cur = next;
+    }
+    std::vector<int> tour = ant_solver.GetResult().vertices;
+    EXPECT_EQ(std::vector<int>(tour.begin(), tour.begin() + nodes), expected);
+
+    // Passes of ants move the pheromones of their edges towards tau0, the background value of ACS
+    ant_solver.SetIterations(5);
+    parameters.ants = 10;
+    parameters.exploitation = 0.9;
+    ant_solver.SetParameters(parameters);
+    ant_solver.SolveWithoutUsingParallelism();
+    s21::EdgeMatrix before = ant_solver.GetPheromones();
+    double tau0 = before.background;
+    parameters.warm_start = true;
+    parameters.evaporation = 0.0;
+    parameters.local_evaporation = 0.5;
+    ant_solver.SetParameters(parameters);
+    ant_solver.SetIterations(1);
+    ant_solver.SolveWithoutUsingParallelism();
+    const s21::EdgeMatrix &after = ant_solver.GetPheromones();
+    int moved = 0;
+    for (std::int64_t index = 0; index < after.get_count(); ++index) {
+        if (after[index] != before[index]) {
+            EXPECT_LE(std::abs(after[index] - tau0), 0.5 * std::abs(before[index] - tau0) * (1 + 1e-9));
+            moved++;
+        }
+    }
+    EXPECT_GT(moved, 0);
+}
+
+TEST(AntAlgorithmTests, Islands) {
+    const int nodes = 30;
+    s21::S21Matrix matrix(nodes, nodes);
+    s21::S21Matrix::FillMatrixWithRandValues(&matrix);
+    s21::AntAlgorithm ant_solver;
+    ant_solver.SetData(matrix, 6);
+    s21::AntParameters parameters = ant_solver.GetParameters();
+    parameters.ants = 20;
+    parameters.islands = 3;
+    parameters.migration_interval = 2;
+    for (auto migration : {s21::MigrationMode::kBestTour, s21::MigrationMode::kPheromoneBlend}) {
+        for (auto topology : {s21::MigrationTopology::kRing, s21::MigrationTopology::kAllToAll}) {
+            parameters.migration = migration;
+            parameters.topology = topology;
+            ant_solver.SetParameters(parameters);
+            ant_solver.SolveUsingThreads(1);
+            s21::TsmResult single = ant_solver.GetResult();
+            ant_solver.SolveUsingThreads(3);
+            EXPECT_EQ(single.vertices, ant_solver.GetResult().vertices);
+            EXPECT_EQ(single.vertices.back(), 1);
+        }
+    }
+    parameters.islands = 0;
+    EXPECT_ANY_THROW(ant_solver.SetParameters(parameters));
+}
+
+TEST(AntAlgorithmTests, IslandMigration) {
+    const int nodes = 30, islands = 3;
+    s21::S21Matrix matrix(nodes, nodes);
+    s21::S21Matrix::FillMatrixWithRandValues(&matrix, 3);
+    s21::AntAlgorithm ant_solver;
+    s21::AntParameters parameters = ant_solver.GetParameters();
+    parameters.ants = 8;
+    parameters.islands = islands;
+    parameters.migration_interval = 1;
+    auto previous = [](int island) { return (island + islands - 1) % islands; };
+
+    // Islands run one iteration apart, then a warm solve migrates after its first iteration
+    for (auto topology : {s21::MigrationTopology::kRing, s21::MigrationTopology::kAllToAll}) {
+        parameters.topology = topology;
+        parameters.migration = s21::MigrationMode::kBestTour;
+        parameters.warm_start = false;
+        ant_solver.SetParameters(parameters);
+        ant_solver.SetData(matrix, 1);
+        ant_solver.SolveWithoutUsingParallelism();
+        std::vector<double> before;
+        for (int i = 0; i < islands; ++i) before.push_back(ant_solver.GetIslandBest(i).distance);
+        double best = *std::min_element(before.begin(), before.end());
+        EXPECT_LT(best, *std::max_element(before.begin(), before.end()));
+        parameters.warm_start = true;
+        ant_solver.SetParameters(parameters);
+        ant_solver.SetIterations(2);
+        ant_solver.SolveWithoutUsingParallelism();
+        for (int i = 0; i < islands; ++i) {
+            double sent = topology == s21::MigrationTopology::kRing ? before[previous(i)] : best;
+            EXPECT_LE(ant_solver.GetIslandBest(i).distance, sent);
+        }
+    }
+
+    // Without evaporation and with tiny deposits the pheromones change only by the blend
+    for (auto topology : {s21::MigrationTopology::kRing, s21::MigrationTopology::kAllToAll}) {
+        parameters.topology = topology;
+        parameters.migration = s21::MigrationMode::kPheromoneBlend;
+        parameters.warm_start = false;
+        parameters.evaporation = 0.5;
+        parameters.Q = 10.0;
+        ant_solver.SetParameters(parameters);
+        ant_solver.SetData(matrix, 1);
+        ant_solver.SolveWithoutUsingParallelism();
+        std::vector<s21::EdgeMatrix> before;
+        for (int i = 0; i < islands; ++i) before.push_back(ant_solver.GetPheromones(i));
+        parameters.warm_start = true;
+        parameters.evaporation = 0.0;
+        parameters.Q = 1e-9;
+        ant_solver.SetParameters(parameters);
+        ant_solver.SetIterations(2);
+        ant_solver.SolveWithoutUsingParallelism();
+        double blend = parameters.migration_blend;
+        int differ = 0;
+        for (int i = 0; i < islands; ++i) {
+            const s21::EdgeMatrix &after = ant_solver.GetPheromones(i);
+            for (std::int64_t index = 0; index < after.get_count(); ++index) {
+                double other = 0.0;
+                if (topology == s21::MigrationTopology::kRing) {
+                    other = before[previous(i)][index];
+                } else {
+                    for (auto &matrix : before) other += matrix[index] / islands;
+                }
+                differ += std::abs(other - before[i][index]) > 1e-3;
+                EXPECT_NEAR(after[index], (1.0 - blend) * before[i][index] + blend * other, 1e-6);
+            }
+        }
+        EXPECT_GT(differ, 0);
+    }
+}
+
+TEST(AntAlgorithmTests, TsplibCoordinates) {
+    std::stringstream file(
+        "NAME : square\nTYPE : TSP\nDIMENSION : 5\nEDGE_WEIGHT_TYPE : EUC_2D\nNODE_COORD_SECTION\n"
+        "1 0 0\n2 30 0\n3 30 40\n4 0 40\n5 15 -1\nEOF\n");
+    std::shared_ptr<s21::DistanceProvider> graph = s21::TsplibLoader::Load(file);
+    ASSERT_NE(graph, nullptr);
+    EXPECT_EQ(graph->get_size(), 5);
+    EXPECT_EQ(graph->Distance(0, 2), 50);
+    EXPECT_EQ(graph->Distance(2, 0), 50);
+
+    s21::AntAlgorithm ant_solver;
+    ant_solver.SetData(graph, 10);
+    s21::AntParameters parameters = ant_solver.GetParameters();
+    parameters.ants = 20;
+    parameters.cache_candidate_edges = true;
+    parameters.candidates = 2;
+    ant_solver.SetParameters(parameters);
+    ant_solver.SolveUsingThreads(2);
+    s21::TsmResult result = ant_solver.GetResult();
+    EXPECT_EQ(result.distance, 140);
+    EXPECT_EQ((int)result.vertices.size(), 6);
+    EXPECT_EQ(graph->Distance(0, 4), 15);
+    // Candidates of node 0 are nodes 4 and 1, their distances are read by the position in the list
+    EXPECT_EQ(graph->CandidateDistance(0, 0, 4), 15);
+    EXPECT_EQ(graph->CandidateDistance(0, 1, 1), 30);
+}
+
+TEST(AntAlgorithmTests, TsplibExplicitAndErrors) {
+    std::stringstream file(
+        "DIMENSION: 3\nEDGE_WEIGHT_TYPE: EXPLICIT\nEDGE_WEIGHT_FORMAT: UPPER_ROW\n"
+        "EDGE_WEIGHT_SECTION\n 5 7\n 9\nEOF\n");
+    std::shared_ptr<s21::DistanceProvider> graph = s21::TsplibLoader::Load(file);
+    ASSERT_NE(graph, nullptr);
+    EXPECT_EQ(graph->Distance(0, 1), 5);
+    EXPECT_EQ(graph->Distance(2, 0), 7);
+    EXPECT_EQ(graph->Distance(2, 1), 9);
+
+    std::stringstream geo("DIMENSION: 2\nEDGE_WEIGHT_TYPE: GEO\nNODE_COORD_SECTION\n1 0.0 0.0\n2 1.0 0.0\n");
+    graph = s21::TsplibLoader::Load(geo);
+    ASSERT_NE(graph, nullptr);
+    EXPECT_EQ(graph->Distance(0, 1), 112);
+
+    std::stringstream broken("DIMENSION: 3\nEDGE_WEIGHT_TYPE: EUC_2D\nNODE_COORD_SECTION\n1 0 0\n2 1 1\n");
+    EXPECT_EQ(s21::TsplibLoader::Load(broken), nullptr);
+    std::stringstream unsupported("DIMENSION: 2\nEDGE_WEIGHT_TYPE: EUC_3D\nNODE_COORD_SECTION\n");
+    EXPECT_EQ(s21::TsplibLoader::Load(unsupported), nullptr);
+}
+
+TEST(AntAlgorithmTests, PheromoneStorage) {
+    const int nodes = 60;
+    std::vector<double> x(nodes), y(nodes);
+    for (int i = 0; i < nodes; ++i) {
+        x[i] = (i * 37) % 101;
+        y[i] = (i * 53) % 97;
+    }
+    s21::AntAlgorithm ant_solver;
+    ant_solver.SetData(std::make_shared<s21::CoordinateDistances>(x, y, s21::EdgeWeightType::kEuclidean), 5);
+    s21::AntParameters parameters = ant_solver.GetParameters();
+    parameters.ants = 20;
+    parameters.candidates = 8;
+    for (auto storage : {s21::EdgeStorage::kSymmetric, s21::EdgeStorage::kCandidates}) {
+        for (auto system :
+             {s21::AntSystem::kAntSystem, s21::AntSystem::kMaxMin, s21::AntSystem::kColonySystem}) {
+            parameters.pheromone_storage = storage;
+            parameters.system = system;
+            ant_solver.SetParameters(parameters);
+            ant_solver.SolveUsingThreads(1);
+            s21::TsmResult single = ant_solver.GetResult();
+            ant_solver.SolveUsingThreads(3);
+            EXPECT_EQ(single.vertices, ant_solver.GetResult().vertices);
+            EXPECT_EQ((int)single.vertices.size(), nodes + 1);
+            EXPECT_EQ(std::set<int>(single.vertices.begin(), single.vertices.end()).size(), (size_t)nodes);
+        }
+    }
+
+    // After one iteration from equal pheromones the ants of every storage walk the same tours: distances
+    // and pheromones in powers of two keep the weights exact in floats
+    const int size = 12, count = 3;
+    s21::S21Matrix distances(size, size);
+    std::mt19937 generator(7);
+    for (int i = 0; i < size; ++i) {
+        for (int j = 0; j < i; ++j) distances(i, j) = distances(j, i) = 1 << generator() % 4;
+    }
+    ant_solver.SetData(distances, 1);
+    parameters.system = s21::AntSystem::kAntSystem;
+    parameters.ants = 10;
+    parameters.candidates = count;
+    parameters.initial_pheromone = 0.25;
+    std::vector<s21::EdgeMatrix> pheromones;
+    for (auto storage :
+         {s21::EdgeStorage::kDense, s21::EdgeStorage::kSymmetric, s21::EdgeStorage::kCandidates}) {
+        parameters.pheromone_storage = storage;
+        ant_solver.SetParameters(parameters);
+        ant_solver.SolveWithoutUsingParallelism();
+        pheromones.push_back(ant_solver.GetPheromones());
+    }
+    const s21::EdgeMatrix &dense = pheromones[0], &symmetric = pheromones[1], &candidates = pheromones[2];
+    EXPECT_EQ(dense.get_count(), size * size);
+    EXPECT_EQ(symmetric.get_count(), size * (size - 1) / 2);
+    EXPECT_EQ(candidates.get_count(), size * count);
+    double evaporated = (1.0 - parameters.evaporation) * parameters.initial_pheromone;
+    EXPECT_NEAR(candidates.background, evaporated, 1e-12);
+    for (int i = 0; i < size; ++i) {
+        for (int j = 0; j < size; ++j) {
+            if (i == j) continue;
+            // Both directions deposit on the one value of the symmetric edge
+            double both = dense.Get(i, j) + dense.Get(j, i) - evaporated;
+            EXPECT_NEAR(symmetric.Get(i, j), both, 1e-5 * both);
+        }
+        for (std::int64_t index = candidates.RowBegin(i); index < candidates.RowEnd(i); ++index) {
+            double value = dense.Get(i, candidates.Column(i, index));
+            EXPECT_NEAR(candidates[index], value, 1e-5 * value);
+        }
+    }
+
+    s21::S21Matrix matrix(10, 10);
+    s21::S21Matrix::FillMatrixWithRandValues(&matrix);
+    matrix(0, 1) = matrix(1, 0) + 1.0;
+    ant_solver.SetData(matrix, 5);
+    parameters.pheromone_storage = s21::EdgeStorage::kSymmetric;
+    EXPECT_ANY_THROW(ant_solver.SetParameters(parameters));
+}
+
+TEST(AntAlgorithmTests, SelectionRules) {
+    s21::S21Matrix matrix(50, 50);
+    s21::S21Matrix::FillMatrixWithRandValues(&matrix);
+    s21::AntAlgorithm ant_solver;
+    ant_solver.SetData(matrix, 5);
+    s21::AntParameters parameters = ant_solver.GetParameters();
+    parameters.ants = 20;
+    for (int candidates : {0, 8}) {
+        for (bool float_weights : {false, true}) {
+            for (auto selection : {s21::SelectionRule::kRoulette, s21::SelectionRule::kTournament}) {
+                parameters.candidates = candidates;
+                parameters.float_weights = float_weights;
+                parameters.selection = selection;
+                ant_solver.SetParameters(parameters);
+                ant_solver.SolveUsingThreads(1);
+                s21::TsmResult single = ant_solver.GetResult();
+                ant_solver.SolveUsingThreads(3);
+                EXPECT_EQ(single.vertices, ant_solver.GetResult().vertices);
+                EXPECT_EQ(single.vertices.back(), 1);
+            }
+        }
+    }
+    parameters.tournament_size = 0;
+    EXPECT_ANY_THROW(ant_solver.SetParameters(parameters));
+}
+
+TEST(AntAlgorithmTests, RouletteAndTournament) {
+    // Zero weights in the middle and on top of the prefix sums, total is 6
+    const double weights[] = {1.0, 2.0, 0.0, 3.0, 0.0};
+    const int count = 5;
+    double prefix[count];
+    float prefix_float[count];
+    const double below_one = std::nextafter(1.0, 0.0);
+    EXPECT_EQ(s21::SpinRoulette(weights, count, prefix, 0.0), 0);
+    EXPECT_EQ(s21::SpinRoulette(weights, count, prefix, 1.0 / 6.0), 1);
+    EXPECT_EQ(s21::SpinRoulette(weights, count, prefix, std::nextafter(0.5, 0.0)), 1);
+    EXPECT_EQ(s21::SpinRoulette(weights, count, prefix, 0.5), 3);
+    EXPECT_EQ(s21::SpinRoulette(weights, count, prefix, below_one), 3);
+    // The float threshold of the last draw rounds up to the total
+    EXPECT_EQ(s21::SpinRoulette(weights, count, prefix_float, 0.0), 0);
+    EXPECT_EQ(s21::SpinRoulette(weights, count, prefix_float, below_one), 3);
+
+    // Draws spread evenly over [0, 1) pick every index as often as its share of the total
+    const int draws = 6000;
+    std::vector<int> picks(count);
+    for (int i = 0; i < draws; ++i) {
+        double random = (i + 0.5) / draws;
+        int index = s21::SpinRoulette(weights, count, prefix, random);
+        EXPECT_EQ(s21::SpinRoulette(weights, count, prefix_float, random), index);
+        picks[index]++;
+    }
+    EXPECT_EQ(picks, std::vector<int>({1000, 2000, 0, 3000, 0}));
+
+    // Generator with the same seed repeats the draws of the tournament
+    const int size = 3;
+    s21::Xoshiro256 random(5), draws_random(5);
+    for (int round = 0; round < 100; ++round) {
+        int best = draws_random.NextBelow(count);
+        for (int k = 1; k < size; ++k) {
+            int drawn = draws_random.NextBelow(count);
+            if (weights[drawn] > weights[best]) best = drawn;
+        }
+        EXPECT_EQ(s21::SpinTournament(weights, count, size, random), best);
+    }
+    s21::Xoshiro256 single(5);
+    for (int round = 0; round < 100; ++round) {
+        int drawn = s21::Xoshiro256(single).NextBelow(count);
+        EXPECT_EQ(s21::SpinTournament(weights, count, 1, single), drawn);
+    }
+}
+
+TEST(AntAlgorithmTests, StoppingCriteria) {
+    s21::S21Matrix matrix(40, 40);
+    s21::S21Matrix::FillMatrixWithRandValues(&matrix);
+    s21::AntAlgorithm ant_solver;
+    ant_solver.SetData(matrix, 1000000);
+    s21::AntParameters parameters = ant_solver.GetParameters();
+    parameters.ants = 20;
+    parameters.time_budget = 0.2;
+    ant_solver.SetParameters(parameters);
+    ant_solver.SolveUsingThreads(2);
+    s21::AntProgress progress = ant_solver.GetProgress();
+    EXPECT_EQ(progress.stop_reason, s21::StopReason::kTimeBudget);
+    EXPECT_EQ(progress.best.vertices, ant_solver.GetResult().vertices);
+    EXPECT_LE(progress.best.distance, progress.iteration_mean);
+
+    parameters.time_budget = 0.0;
+    parameters.target_length = 1e12;
+    ant_solver.SetParameters(parameters);
+    ant_solver.SolveUsingThreads(2);
+    EXPECT_EQ(ant_solver.GetProgress().stop_reason, s21::StopReason::kTargetLength);
+    EXPECT_EQ(ant_solver.GetProgress().iteration, 1);
+
+    parameters.target_length = 0.0;
+    parameters.stagnation_limit = 3;
+    ant_solver.SetParameters(parameters);
+    ant_solver.SolveUsingThreads(2);
+    EXPECT_EQ(ant_solver.GetProgress().stop_reason, s21::StopReason::kStagnation);
+    EXPECT_EQ(ant_solver.GetProgress().stagnation, 3);
+
+    parameters.stagnation_limit = 0;
+    ant_solver.SetParameters(parameters);
+    int calls = 0;
+    ant_solver.SetProgressCallback([&](const s21::AntProgress &state) {
+        EXPECT_EQ(state.iteration, ++calls);
+        if (state.iteration == 5) ant_solver.Cancel();
+    });
+    ant_solver.SolveUsingThreads(2);
+    EXPECT_EQ(ant_solver.GetProgress().stop_reason, s21::StopReason::kCancelled);
+    EXPECT_EQ(calls, 5);
+
+    ant_solver.SetProgressCallback(nullptr);
+    parameters.islands = 2;
+    ant_solver.SetParameters(parameters);
+    std::thread canceller([&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        ant_solver.Cancel();
+    });
+    ant_solver.SolveUsingThreads(2);
+    canceller.join();
+    EXPECT_EQ(ant_solver.GetProgress().stop_reason, s21::StopReason::kCancelled);
+    EXPECT_EQ(ant_solver.GetResult().vertices.back(), 1);
+}
+
+TEST(AntAlgorithmTests, WarmStartAndCheckpoint) {
+    const int nodes = 40;
+    s21::S21Matrix matrix(nodes, nodes);
+    s21::S21Matrix::FillMatrixWithRandValues(&matrix);
+    s21::S21Matrix copy = matrix;
+    s21::AntAlgorithm ant_solver;
+    std::stringstream state;
+    EXPECT_ANY_THROW(ant_solver.SaveState(state));
+    ant_solver.SetData(matrix, 30);
+    s21::AntParameters parameters = ant_solver.GetParameters();
+    parameters.ants = 20;
+    parameters.warm_start = true;
+    ant_solver.SetParameters(parameters);
+    ant_solver.SolveUsingThreads(2);
+    ant_solver.SaveState(state);
+
+    // Edge of the best tour becomes too long to be used
+    s21::TsmResult cold = ant_solver.GetResult();
+    int from = cold.vertices[0] - 1, to = cold.vertices[1] - 1;
+    ant_solver.SetIterations(5);
+    ant_solver.UpdateEdge(from, to, 1e6);
+    ant_solver.SolveUsingThreads(2);
+    s21::TsmResult warm = ant_solver.GetResult();
+    EXPECT_LT(warm.distance, 1e6);
+    EXPECT_EQ(warm.vertices.back(), 1);
+
+    s21::AntAlgorithm restored;
+    restored.SetData(copy, 5);
+    restored.SetParameters(parameters);
+    ASSERT_TRUE(restored.LoadState(state));
+    restored.UpdateEdge(from, to, 1e6);
+    restored.SolveUsingThreads(1);
+    EXPECT_EQ(restored.GetResult().vertices, warm.vertices);
+
+    s21::S21Matrix small(10, 10);
+    s21::S21Matrix::FillMatrixWithRandValues(&small);
+    restored.SetData(small, 5);
+    state.seekg(0);
+    EXPECT_FALSE(restored.LoadState(state));
+    std::stringstream garbage("not a checkpoint");
+    EXPECT_FALSE(restored.LoadState(garbage));
+}
+
 TEST(WinogradAlgoTests, EvenMatrices) {
     s21::S21Matrix m1(100, 100);
     s21::S21Matrix m2(100, 100);
@@ -202,6 +859,291 @@ TEST(WinogradAlgoTests, WrongDimensions) {
     EXPECT_TRUE(res3 == expected);
 }
 
+TEST(WinogradAlgoTests, PreparedOperand) {
+    s21::S21Matrix m2(37, 29);
+    s21::S21Matrix::FillMatrixWithRandValues(&m2);
+    s21::WinogradPreparedOperand prepared(&m2, s21::WinogradPreparedOperand::Side::kRight);
+    s21::WinogradAlgorithm algorithm;
+
+    for (int rows = 1; rows < 20; rows += 6) {
+        s21::S21Matrix m1(rows, 37);
+        s21::S21Matrix::FillMatrixWithRandValues(&m1);
+        s21::S21Matrix expected = m1 * m2;
+        EXPECT_TRUE(algorithm.SolveWithPreparedOperand(&m1, prepared) == expected);
+        EXPECT_TRUE(algorithm.SolveWithPreparedOperand(&m1, prepared, 4) == expected);
+    }
+    EXPECT_TRUE(prepared.IsActual());
+}
+
+TEST(WinogradAlgoTests, PreparedOperandInvalidation) {
+    s21::S21Matrix m1(8, 5);
+    s21::S21Matrix m2(5, 3);
+    s21::S21Matrix::FillMatrixWithRandValues(&m1);
+    s21::S21Matrix::FillMatrixWithRandValues(&m2);
+    s21::WinogradPreparedOperand prepared(&m2, s21::WinogradPreparedOperand::Side::kRight);
+    s21::WinogradAlgorithm algorithm;
+
+    m2(4, 2) += 1000.0;
+    EXPECT_FALSE(prepared.IsActual());
+    EXPECT_TRUE(algorithm.SolveWithPreparedOperand(&m1, prepared) == m1 * m2);
+    EXPECT_TRUE(prepared.IsActual());
+
+    m2.mul_number(2.0);
+    EXPECT_FALSE(prepared.IsActual());
+    EXPECT_TRUE(algorithm.SolveWithPreparedOperand(&m1, prepared, 2) == m1 * m2);
+
+    s21::S21Matrix wrong(8, 4);
+    EXPECT_TRUE(algorithm.SolveWithPreparedOperand(&wrong, prepared) == s21::S21Matrix());
+}
+
+TEST(WinogradAlgoTests, PreparedOperandsStayActual) {
+    s21::S21Matrix m1(9, 6);
+    s21::S21Matrix m2(6, 7);
+    s21::S21Matrix::FillMatrixWithRandValues(&m1, 1);
+    s21::S21Matrix::FillMatrixWithRandValues(&m2, 2);
+    s21::WinogradPreparedOperand left(&m1, s21::WinogradPreparedOperand::Side::kLeft);
+    s21::WinogradPreparedOperand right(&m2, s21::WinogradPreparedOperand::Side::kRight);
+    s21::WinogradAlgorithm algorithm;
+
+    EXPECT_TRUE(algorithm.SolveWithPreparedOperands(left, right, 3) == m1 * m2);
+    EXPECT_TRUE(left.IsActual());
+    EXPECT_TRUE(right.IsActual());
+    EXPECT_TRUE(algorithm.SolveWithoutParallelism(&m1, &m2) == m1 * m2);
+    EXPECT_TRUE(algorithm.SolveWithPipelineParallelism(&m1, &m2) == m1 * m2);
+    EXPECT_TRUE(algorithm.SolveWithClassicParallelism(&m1, &m2, 2) == m1 * m2);
+    EXPECT_TRUE(left.IsActual());
+    EXPECT_TRUE(right.IsActual());
+}
+
+TEST(MatrixChainTests, OptimalOrder) {
+    s21::S21Matrix a(10, 30), b(30, 5), c(5, 60);
+    s21::MatrixChain chain;
+
+    EXPECT_TRUE(chain.SetOperands({&a, &b, &c}));
+    EXPECT_EQ(chain.GetParenthesization(), "((A1A2)A3)");
+    EXPECT_EQ(chain.get_flops(), 4500u);
+}
+
+TEST(MatrixChainTests, MixedShapes) {
+    s21::S21Matrix a(13, 40), b(40, 7), c(7, 31), d(31, 2), e(2, 17);
+    // Small values keep every intermediate product exactly representable in double
+    for (s21::S21Matrix *m : {&a, &b, &c, &d, &e}) {
+        for (int i = 0; i < m->get_rows(); i++) {
+            for (int j = 0; j < m->get_cols(); j++) (*m)(i, j) = rand() % 5;
+        }
+    }
+    s21::MatrixChain chain;
+
+    s21::S21Matrix expected = a * b * c * d * e;
+    EXPECT_TRUE(chain.SetOperands({&a, &b, &c, &d, &e}));
+    EXPECT_TRUE(chain.Solve() == expected);
+    EXPECT_TRUE(chain.Solve(4) == expected);
+}
+
+TEST(MatrixChainTests, WrongDimensions) {
+    s21::S21Matrix a(3, 4), b(5, 6);
+    s21::MatrixChain chain;
+
+    EXPECT_FALSE(chain.SetOperands({&a, &b}));
+    EXPECT_TRUE(chain.Solve() == s21::S21Matrix());
+}
+
+TEST(IntegerWinogradTests, SameAsDoublePath) {
+    s21::S21Matrix m1(45, 67);
+    s21::S21Matrix m2(67, 33);
+    s21::S21Matrix::FillMatrixWithRandValues(&m1);
+    s21::S21Matrix::FillMatrixWithRandValues(&m2);
+    s21::IntegerWinogradAlgorithm<std::int32_t> algorithm32;
+    s21::IntegerWinogradAlgorithm<std::int64_t> algorithm64;
+
+    s21::S21Matrix expected = m1 * m2;
+    EXPECT_TRUE(algorithm32.Solve(&m1, &m2) == expected);
+    EXPECT_TRUE(algorithm32.Solve(&m1, &m2, 3) == expected);
+    EXPECT_TRUE(algorithm64.Solve(&m1, &m2, 4) == expected);
+}
+
+TEST(IntegerWinogradTests, ExactForLargeValues) {
+    const std::int32_t big = 300000000;
+    s21::IntegerMatrix<std::int32_t> m1(3, 21), m2(21, 2);
+    for (int j = 0; j < 21; j++) {
+        m1(0, j) = big;
+        m1(1, j) = -big;
+        m1(2, j) = j % 2 ? big : 1;
+        m2(j, 0) = big - j;
+        m2(j, 1) = 1;
+    }
+    s21::IntegerWinogradAlgorithm<std::int64_t> algorithm;
+    s21::IntegerMatrix<std::int64_t> res = algorithm.Solve(m1, m2, 2);
+
+    ASSERT_FALSE(res.is_empty());
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 2; j++) {
+            std::int64_t expected = 0;
+            for (int k = 0; k < 21; k++) expected += (std::int64_t)m1(i, k) * m2(k, j);
+            EXPECT_EQ(res(i, j), expected);
+        }
+    }
+}
+
+TEST(IntegerWinogradTests, OverflowAndInvalidValues) {
+    s21::IntegerMatrix<std::int32_t> m1(2, 4), m2(4, 2);
+    m1(0, 0) = 100000;
+    m2(0, 0) = 100000;
+    s21::IntegerWinogradAlgorithm<std::int32_t> algorithm32;
+    s21::IntegerWinogradAlgorithm<std::int64_t> algorithm64;
+    EXPECT_TRUE(algorithm32.Solve(m1, m2).is_empty());
+    EXPECT_EQ(algorithm64.Solve(m1, m2)(0, 0), 10000000000LL);
+
+    s21::S21Matrix m3(2, 2), m4(2, 2);
+    m3(0, 1) = 0.5;
+    EXPECT_TRUE(algorithm64.Solve(&m3, &m4) == s21::S21Matrix());
+}
+
+TEST(AsyncWinogradTests, SubmitAndChain) {
+    s21::S21Matrix m1(20, 15), m2(15, 30), m3(30, 7);
+    for (s21::S21Matrix *m : {&m1, &m2, &m3}) s21::S21Matrix::FillMatrixWithRandValues(m);
+    s21::AsyncWinograd async;
+
+    s21::MultiplyTask first = async.Submit(m1, m2, s21::WinogradMode::kClassicParallelism, 4);
+    s21::MultiplyTask second = first.Then(m3, s21::WinogradMode::kPipelineParallelism);
+    s21::MultiplyTask doubled = second.Then([](s21::S21Matrix &m) {
+        m.mul_number(2.0);
+        return m;
+    });
+    s21::S21Matrix expected = m1 * m2;
+    EXPECT_TRUE(first.Get() == expected);
+    expected = expected * m3;
+    EXPECT_TRUE(second.Get() == expected);
+    expected.mul_number(2.0);
+    EXPECT_TRUE(doubled.Get() == expected);
+}
+
+TEST(AsyncWinogradTests, CancelPendingTask) {
+    s21::Executor executor(1);
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+    executor.Submit([released] { released.wait(); });
+
+    s21::S21Matrix m1(5, 5), m2(5, 5);
+    s21::AsyncWinograd async(executor);
+    s21::MultiplyTask task = async.Submit(m1, m2);
+    s21::MultiplyTask dependent = task.Then(m2);
+    std::promise<bool> callback_called;
+    task.OnComplete([&](s21::MultiplyTask finished) { callback_called.set_value(finished.IsCancelled()); });
+
+    EXPECT_FALSE(task.IsReady());
+    EXPECT_TRUE(task.Cancel());
+    release.set_value();
+    EXPECT_TRUE(callback_called.get_future().get());
+    EXPECT_TRUE(dependent.IsCancelled());
+    EXPECT_ANY_THROW(task.Get());
+}
+
+TEST(ExecutorTests, ParallelForAndReduce) {
+    s21::Executor executor(3);
+    std::vector<int> hits(1000, 0);
+    executor.ParallelFor(0, 1000, 7, 4, [&](int begin, int end) {
+        for (int i = begin; i < end; ++i) hits[i]++;
+    });
+    EXPECT_TRUE(std::all_of(hits.begin(), hits.end(), [](int hit) { return hit == 1; }));
+
+    auto harmonic = [&](int threads) {
+        return executor.ParallelReduce(
+            0, 1000, 16, threads, 0.0,
+            [](int begin, int end) {
+                double part = 0.0;
+                for (int i = begin; i < end; ++i) part += 1.0 / (i + 1);
+                return part;
+            },
+            [](double left, double right) { return left + right; });
+    };
+    EXPECT_EQ(harmonic(1), harmonic(4));
+
+    // Loops nested in tasks are finished by the waiting threads
+    std::atomic<int> total(0);
+    executor.ParallelRun(8, [&](int) {
+        executor.ParallelFor(0, 100, 1, 3, [&](int begin, int end) { total += end - begin; });
+    });
+    EXPECT_EQ(total, 800);
+}
+
+TEST(ExecutorTests, WaiterRunsOnlyItsTasks) {
+    s21::Executor executor(1);
+    std::promise<std::thread::id> unrelated;
+    executor.Submit([&] { unrelated.set_value(std::this_thread::get_id()); });
+    std::atomic<int> runs(0);
+    executor.ParallelRun(4, [&](int) { runs++; });
+    EXPECT_EQ(runs, 4);
+    EXPECT_NE(unrelated.get_future().get(), std::this_thread::get_id());
+
+    s21::Executor::Instance();
+    EXPECT_FALSE(s21::Executor::Configure(2));
+}
+
+TEST(BatchTests, OptionsAndReport) {
+    const char *arguments[] = {"gauss.out", "--size", "10", "--mode", "serial,parallel", "--format", "csv",
+                               "--repetitions", "3"};
+    s21::BatchOptions options;
+    EXPECT_TRUE(s21::BatchOptions::Parse(9, const_cast<char **>(arguments), options));
+    EXPECT_EQ(options.size, 10);
+    EXPECT_EQ(options.repetitions, 3);
+    EXPECT_TRUE(options.format == s21::BatchFormat::kCsv);
+    EXPECT_TRUE(options.HasMode("parallel"));
+    EXPECT_FALSE(options.HasMode("pipeline"));
+    EXPECT_TRUE(options.CheckModes({"serial", "parallel"}));
+    options.modes = {"serial", "paralel"};
+    EXPECT_FALSE(options.CheckModes({"serial", "parallel"}));
+
+    const char *wrong[] = {"gauss.out", "--threads", "0"};
+    s21::BatchOptions wrong_options;
+    EXPECT_FALSE(s21::BatchOptions::Parse(3, const_cast<char **>(wrong), wrong_options));
+
+    std::stringstream out;
+    {
+        s21::BatchReport report(out, s21::BatchFormat::kCsv);
+        s21::BatchRecord record;
+        record.algorithm = "gauss";
+        record.mode = "serial";
+        record.input = "a,\"b\"";
+        record.timing = s21::TimingHarness::Summarize({0.5, 0.25});
+        record.checksum = 6.0;
+        report.Write(record);
+    }
+    std::string header, line;
+    std::getline(out, header);
+    std::getline(out, line);
+    EXPECT_EQ(line, "\"gauss\",\"serial\",\"a,\"\"b\"\"\",0,0,1,0,2,0.25,0.375,0.475,0.4975,0.375,"
+                    "0.176776695,0,6");
+
+    std::stringstream json;
+    {
+        s21::BatchReport report(json, s21::BatchFormat::kJson);
+        s21::BatchRecord record;
+        record.checksum = std::numeric_limits<double>::infinity();
+        report.Write(record);
+    }
+    EXPECT_NE(json.str().find("\"checksum\": null}"), std::string::npos);
+}
+
+TEST(TimingTests, SummarizeAndMeasure) {
+    s21::TimingStats stats = s21::TimingHarness::Summarize({3, 1, 100, 2, 4});
+    EXPECT_DOUBLE_EQ(stats.min, 1);
+    EXPECT_DOUBLE_EQ(stats.median, 3);
+    EXPECT_DOUBLE_EQ(stats.p90, 61.6);
+    EXPECT_DOUBLE_EQ(stats.mean, 22);
+    EXPECT_NEAR(stats.stddev, 43.617, 1e-3);
+    EXPECT_EQ(stats.outliers, 1);
+
+    int setups = 0, runs = 0;
+    s21::TimingHarness harness(4, 2);
+    stats = harness.Measure([&] { setups++; }, [&] { runs++; });
+    EXPECT_EQ(setups, 6);
+    EXPECT_EQ(runs, 6);
+    EXPECT_EQ(stats.samples.size(), 4u);
+    EXPECT_LE(stats.min, stats.median);
+    EXPECT_LE(stats.median, stats.p99);
+}
+
 TEST(GaussAlgoTests, Rows3Cols4) {
     s21::S21Matrix expected(1, 3);
     expected(0, 0) = 1;
@@ -0,0 +1,182 @@
+#include "Executor.h"
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace s21 {
+namespace {
+int configured_workers = 0;
+bool configured_pinning = false;
+std::atomic<bool> instance_created(false);
+
+// Worker of which executor the current thread is, so tasks submitted by a task stay on its worker
+thread_local const Executor *current_executor = nullptr;
+thread_local int current_worker = -1;
+
+int GetInstanceWorkers() {
+    instance_created = true;
+    return configured_workers > 0 ? configured_workers : (int)std::thread::hardware_concurrency();
+}
+
+// Ids of one ParallelRun are claimed by its tasks and by the calling thread, whichever comes first.
+// Tasks that come too late find nothing to do; they may outlive the call, so they share the group
+class TaskGroup {
+public:
+    TaskGroup(const std::function<void(int)> &body, int count) : body_(body), count_(count), next_(1) {
+        remaining_ = count - 1;
+    }
+
+    bool RunNext() {
+        int id = next_++;
+        if (id >= count_) return false;
+        body_(id);
+        std::lock_guard<std::mutex> lock(mtx_);
+        if (--remaining_ == 0) done_.notify_all();
+        return true;
+    }
+    void Wait() {
+        std::unique_lock<std::mutex> lock(mtx_);
+        done_.wait(lock, [this] { return remaining_ == 0; });
+    }
+
+private:
+    const std::function<void(int)> &body_;
+    int count_;
+    std::atomic<int> next_;
+    int remaining_;
+    std::mutex mtx_;
+    std::condition_variable done_;
+};
+
+void PinThread(int index) {
+#ifdef __linux__
+    int cpus = std::max(1, (int)std::thread::hardware_concurrency());
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(index % cpus, &set);
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#else
+    (void)index;
+#endif
+}
+}  // namespace
+
+Executor::Executor(int workers, bool pin_threads) : pending_(0), stop_(false) {
+    if (workers < 1) workers = 1;
+    for (int i = 0; i < workers; i++) {
+        queues_.push_back(std::make_unique<Queue>());
+    }
+    for (int i = 0; i < workers; i++) {
+        workers_.emplace_back(&Executor::WorkerLoop, this, i, pin_threads);
+    }
+}
+
+Executor::~Executor() {
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        stop_ = true;
+    }
+    cv_.notify_all();
+    for (auto &worker : workers_) worker.join();
+}
+
+Executor &Executor::Instance() {
+    static Executor executor(GetInstanceWorkers(), configured_pinning);
+    return executor;
+}
+
+bool Executor::Configure(int workers, bool pin_threads) {
+    if (instance_created) return false;
+    configured_workers = workers;
+    configured_pinning = pin_threads;
+    return true;
+}
+
+void Executor::Submit(std::function<void()> task) {
+    int index = GetCurrentWorker();
+    Queue &queue = index >= 0 ? *queues_[index] : shared_;
+    {
+        std::lock_guard<std::mutex> lock(queue.mtx);
+        queue.tasks.push_back(std::move(task));
+    }
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        pending_++;
+    }
+    cv_.notify_one();
+}
+
+int Executor::get_workers() const { return workers_.size(); }
+
+void Executor::ParallelRun(int count, const std::function<void(int)> &body) {
+    if (count <= 1) {
+        if (count == 1) body(0);
+        return;
+    }
+    auto group = std::make_shared<TaskGroup>(body, count);
+    for (int id = 1; id < count; ++id) {
+        Submit([group] { group->RunNext(); });
+    }
+    body(0);
+    while (group->RunNext()) {
+    }
+    group->Wait();
+}
+
+void Executor::ParallelFor(int begin, int end, int grain, int threads,
+                           const std::function<void(int, int)> &body) {
+    if (end <= begin) return;
+    grain = std::max(1, grain);
+    int blocks = (end - begin + grain - 1) / grain;
+    std::atomic<int> next_block(0);
+    ParallelRun(std::max(1, std::min(threads, blocks)), [&](int) {
+        for (int block = next_block++; block < blocks; block = next_block++) {
+            body(begin + block * grain, std::min(end, begin + (block + 1) * grain));
+        }
+    });
+}
+
+void Executor::WorkerLoop(int index, bool pin_thread) {
+    current_executor = this;
+    current_worker = index;
+    if (pin_thread) PinThread(index);
+    while (true) {
+        if (RunTask(index)) continue;
+        std::unique_lock<std::mutex> lock(mtx_);
+        cv_.wait(lock, [&] { return stop_ || pending_ > 0; });
+        // Remaining tasks are finished before the pool stops
+        if (stop_ && pending_ == 0) return;
+    }
+}
+
+int Executor::GetCurrentWorker() const { return current_executor == this ? current_worker : -1; }
+
+bool Executor::RunTask(int index) {
+    std::function<void()> task;
+    auto take = [&](Queue &queue, bool newest) {
+        std::lock_guard<std::mutex> lock(queue.mtx);
+        if (queue.tasks.empty()) return false;
+        if (newest) {
+            task = std::move(queue.tasks.back());
+            queue.tasks.pop_back();
+        } else {
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+        }
+        return true;
+    };
+    int workers = queues_.size();
+    bool found = (index >= 0 && take(*queues_[index], true)) || take(shared_, false);
+    for (int k = 1; !found && k <= workers; ++k) {
+        int victim = (std::max(index, 0) + k) % workers;
+        found = victim != index && take(*queues_[victim], false);
+    }
+    if (!found) return false;
+    pending_--;
+    task();
+    return true;
+}
+
+}  // namespace s21
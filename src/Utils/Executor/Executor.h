@@ -0,0 +1,79 @@
+#ifndef PARALLELS_EXECUTOR_H
+#define PARALLELS_EXECUTOR_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace s21 {
+
+// Pool of worker threads with a deque of tasks per worker. A worker runs its own tasks newest first,
+// then tasks submitted from outside the pool in FIFO order, then steals the oldest tasks of others
+class Executor {
+public:
+    explicit Executor(int workers, bool pin_threads = false);
+    ~Executor();
+    Executor(const Executor &) = delete;
+    Executor &operator=(const Executor &) = delete;
+
+    // Process-wide executor, by default with one worker per hardware thread
+    static Executor &Instance();
+    // Workers of the process-wide executor. Returns false after its first use, when the pool already
+    // exists. Pinned workers are bound to hardware threads in order
+    static bool Configure(int workers, bool pin_threads = false);
+
+    void Submit(std::function<void()> task);
+    int get_workers() const;
+
+    // Runs body(id) for every id in [0, count) and returns when all are done. The calling thread runs
+    // id 0 and every id no worker has started yet, then sleeps until the started ones finish. It never
+    // runs tasks of other calls, so parallel loops may be nested in tasks
+    void ParallelRun(int count, const std::function<void(int)> &body);
+    // Blocks of grain indices of [begin, end) are taken dynamically by at most threads participants,
+    // body gets the bounds of a block
+    void ParallelFor(int begin, int end, int grain, int threads, const std::function<void(int, int)> &body);
+    // Results of blocks are combined in the order of blocks, so the result does not depend on threads
+    template <class T, class Map, class Reduce>
+    T ParallelReduce(int begin, int end, int grain, int threads, T identity, Map map, Reduce reduce) {
+        if (end <= begin) return identity;
+        grain = std::max(1, grain);
+        int blocks = (end - begin + grain - 1) / grain;
+        std::vector<T> partial(blocks, identity);
+        ParallelFor(0, blocks, 1, threads, [&](int first, int last) {
+            for (int block = first; block < last; ++block) {
+                partial[block] = map(begin + block * grain, std::min(end, begin + (block + 1) * grain));
+            }
+        });
+        T result = identity;
+        for (const T &value : partial) result = reduce(result, value);
+        return result;
+    }
+
+private:
+    struct Queue {
+        std::deque<std::function<void()>> tasks;
+        std::mutex mtx;
+    };
+
+    std::vector<std::unique_ptr<Queue>> queues_;
+    Queue shared_;  // tasks submitted from outside the pool
+    std::vector<std::thread> workers_;
+    std::atomic<int> pending_;
+    std::mutex mtx_;
+    std::condition_variable cv_;
+    bool stop_;
+
+    void WorkerLoop(int index, bool pin_thread);
+    int GetCurrentWorker() const;
+    bool RunTask(int index);
+};
+
+}  // namespace s21
+
+#endif  // PARALLELS_EXECUTOR_H
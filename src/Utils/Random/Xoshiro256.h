@@ -0,0 +1,56 @@
+#ifndef PARALLELS_XOSHIRO256_H
+#define PARALLELS_XOSHIRO256_H
+
+#include <cstdint>
+
+namespace s21 {
+
+// xoshiro256** generator. It is cheap to create, so every independent stream (an ant, a thread)
+// gets its own generator seeded from a master seed and the number of the stream.
+class Xoshiro256 {
+public:
+    explicit Xoshiro256(std::uint64_t seed = 0) { Seed(seed); }
+
+    void Seed(std::uint64_t seed) {
+        for (std::uint64_t &word : state_) word = SplitMix64(seed);
+    }
+
+    static std::uint64_t StreamSeed(std::uint64_t master_seed, std::uint64_t stream) {
+        std::uint64_t seed = master_seed ^ (stream * 0x9e3779b97f4a7c15ULL);
+        return SplitMix64(seed);
+    }
+
+    std::uint64_t Next() {
+        std::uint64_t result = Rotl(state_[1] * 5, 7) * 9;
+        std::uint64_t t = state_[1] << 17;
+        state_[2] ^= state_[0];
+        state_[3] ^= state_[1];
+        state_[1] ^= state_[2];
+        state_[0] ^= state_[3];
+        state_[2] ^= t;
+        state_[3] = Rotl(state_[3], 45);
+        return result;
+    }
+
+    // Uniform value in [0, 1)
+    double NextDouble() { return (Next() >> 11) * 0x1.0p-53; }
+
+    // Uniform value in [0, bound) by multiplication instead of the division of modulo
+    std::uint32_t NextBelow(std::uint32_t bound) { return ((Next() >> 32) * bound) >> 32; }
+
+private:
+    std::uint64_t state_[4];
+
+    static std::uint64_t Rotl(std::uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+    static std::uint64_t SplitMix64(std::uint64_t &x) {
+        std::uint64_t z = (x += 0x9e3779b97f4a7c15ULL);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        return z ^ (z >> 31);
+    }
+};
+
+}  // namespace s21
+
+#endif  // PARALLELS_XOSHIRO256_H
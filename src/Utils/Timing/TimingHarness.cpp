@@ -0,0 +1,57 @@
+#include "TimingHarness.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+namespace s21 {
+namespace {
+// Linear interpolation between the closest ranks of sorted samples
+double Percentile(const std::vector<double> &sorted, double share) {
+    double position = share * (sorted.size() - 1);
+    size_t lower = (size_t)position;
+    size_t upper = std::min(lower + 1, sorted.size() - 1);
+    return sorted[lower] + (position - lower) * (sorted[upper] - sorted[lower]);
+}
+}  // namespace
+
+std::string TimingStats::ToString() const {
+    char buffer[256];
+    std::snprintf(buffer, sizeof(buffer),
+                  "min %.6lfs  median %.6lfs  p90 %.6lfs  p99 %.6lfs  stddev %.6lfs  outliers %d of %d", min,
+                  median, p90, p99, stddev, outliers, (int)samples.size());
+    return buffer;
+}
+
+TimingHarness::TimingHarness(int repetitions, int warmups)
+    : repetitions_(std::max(1, repetitions)), warmups_(std::max(0, warmups)) {}
+
+int TimingHarness::get_repetitions() const { return repetitions_; }
+
+int TimingHarness::get_warmups() const { return warmups_; }
+
+TimingStats TimingHarness::Summarize(const std::vector<double> &samples) {
+    TimingStats stats;
+    stats.samples = samples;
+    if (samples.empty()) return stats;
+    std::vector<double> sorted = samples;
+    std::sort(sorted.begin(), sorted.end());
+    stats.min = sorted.front();
+    stats.median = Percentile(sorted, 0.5);
+    stats.p90 = Percentile(sorted, 0.9);
+    stats.p99 = Percentile(sorted, 0.99);
+    for (double sample : sorted) stats.mean += sample;
+    stats.mean /= sorted.size();
+    if (sorted.size() > 1) {
+        double squares = 0.0;
+        for (double sample : sorted) squares += (sample - stats.mean) * (sample - stats.mean);
+        stats.stddev = std::sqrt(squares / (sorted.size() - 1));
+    }
+    double q1 = Percentile(sorted, 0.25), q3 = Percentile(sorted, 0.75);
+    double fence = 1.5 * (q3 - q1);
+    stats.outliers = std::count_if(sorted.begin(), sorted.end(),
+                                   [&](double sample) { return sample < q1 - fence || sample > q3 + fence; });
+    return stats;
+}
+
+}  // namespace s21
@@ -0,0 +1,65 @@
+#ifndef PARALLELS_TIMINGHARNESS_H
+#define PARALLELS_TIMINGHARNESS_H
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace s21 {
+
+// Statistics of timed runs in seconds. Outliers lie outside the Tukey fences, farther than 1.5
+// interquartile ranges from the quartiles; they are counted, not dropped
+struct TimingStats {
+    std::vector<double> samples;  // in the order of runs
+    double min = 0.0;
+    double median = 0.0;
+    double p90 = 0.0;
+    double p99 = 0.0;
+    double mean = 0.0;
+    double stddev = 0.0;
+    int outliers = 0;
+
+    std::string ToString() const;
+};
+
+// Runs a job a few times untimed to warm caches, the allocator and the thread pool up, then times
+// every repetition on its own. Setup runs before each run outside of the time, so copies of the
+// input and similar preparations are not measured
+class TimingHarness {
+public:
+    explicit TimingHarness(int repetitions, int warmups = 1);
+
+    template <class Setup, class Run>
+    TimingStats Measure(Setup setup, Run run) const {
+        for (int i = 0; i < warmups_; ++i) {
+            setup();
+            run();
+        }
+        std::vector<double> samples;
+        for (int i = 0; i < repetitions_; ++i) {
+            setup();
+            auto start = std::chrono::steady_clock::now();
+            run();
+            std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+            samples.push_back(elapsed.count());
+        }
+        return Summarize(samples);
+    }
+    template <class Run>
+    TimingStats Measure(Run run) const {
+        return Measure([] {}, run);
+    }
+
+    int get_repetitions() const;
+    int get_warmups() const;
+
+    static TimingStats Summarize(const std::vector<double> &samples);
+
+private:
+    int repetitions_;
+    int warmups_;
+};
+
+}  // namespace s21
+
+#endif  // PARALLELS_TIMINGHARNESS_H
@@ -0,0 +1,88 @@
+#include "TsplibLoader.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+namespace s21 {
+namespace {
+std::string Trim(const std::string &line) {
+    size_t begin = line.find_first_not_of(" \t\r");
+    size_t end = line.find_last_not_of(" \t\r");
+    return begin == std::string::npos ? "" : line.substr(begin, end - begin + 1);
+}
+}  // namespace
+
+std::shared_ptr<DistanceProvider> TsplibLoader::Load(std::istream &file) {
+    int dimension = 0;
+    std::string type, format = "FULL_MATRIX", line;
+    while (std::getline(file, line)) {
+        line = Trim(line);
+        size_t colon = line.find(':');
+        std::string key = Trim(line.substr(0, colon));
+        std::string value = colon == std::string::npos ? "" : Trim(line.substr(colon + 1));
+        if (key == "DIMENSION") {
+            dimension = std::atoi(value.c_str());
+        } else if (key == "EDGE_WEIGHT_TYPE") {
+            type = value;
+        } else if (key == "EDGE_WEIGHT_FORMAT") {
+            format = value;
+        } else if (key == "NODE_COORD_SECTION") {
+            if (dimension <= 0) return nullptr;
+            if (type == "EUC_2D") return LoadCoordinates(file, dimension, EdgeWeightType::kEuclidean);
+            if (type == "GEO") return LoadCoordinates(file, dimension, EdgeWeightType::kGeographical);
+            if (type == "ATT") return LoadCoordinates(file, dimension, EdgeWeightType::kPseudoEuclidean);
+            return nullptr;
+        } else if (key == "EDGE_WEIGHT_SECTION") {
+            if (dimension <= 0 || type != "EXPLICIT") return nullptr;
+            return LoadWeights(file, dimension, format);
+        } else if (key == "EOF") {
+            break;
+        }
+    }
+    return nullptr;
+}
+
+std::shared_ptr<DistanceProvider> TsplibLoader::LoadCoordinates(std::istream &file, int dimension,
+                                                                EdgeWeightType type) {
+    std::vector<double> x(dimension), y(dimension);
+    std::vector<char> read(dimension);
+    for (int i = 0; i < dimension; ++i) {
+        int id;
+        double node_x, node_y;
+        if (!(file >> id >> node_x >> node_y) || id < 1 || id > dimension || read[id - 1]) {
+            return nullptr;
+        }
+        x[id - 1] = node_x;
+        y[id - 1] = node_y;
+        read[id - 1] = 1;
+    }
+    return std::make_shared<CoordinateDistances>(std::move(x), std::move(y), type);
+}
+
+std::shared_ptr<DistanceProvider> TsplibLoader::LoadWeights(std::istream &file, int dimension,
+                                                            const std::string &format) {
+    S21Matrix matrix(dimension, dimension);
+    bool full = format == "FULL_MATRIX";
+    bool upper = format == "UPPER_ROW" || format == "UPPER_DIAG_ROW";
+    bool lower = format == "LOWER_ROW" || format == "LOWER_DIAG_ROW";
+    bool diagonal = format == "UPPER_DIAG_ROW" || format == "LOWER_DIAG_ROW";
+    if (!full && !upper && !lower) {
+        return nullptr;
+    }
+    for (int i = 0; i < dimension; ++i) {
+        int first = full ? 0 : upper ? (diagonal ? i : i + 1) : 0;
+        int end = full || upper ? dimension : (diagonal ? i + 1 : i);
+        for (int j = first; j < end; ++j) {
+            double value;
+            if (!(file >> value)) {
+                return nullptr;
+            }
+            matrix(i, j) = value;
+            if (!full) {
+                matrix(j, i) = value;
+            }
+        }
+    }
+    return std::make_shared<MatrixDistances>(std::move(matrix));
+}
+}  // namespace s21
@@ -0,0 +1,27 @@
+#ifndef PARALLELS_TSPLIBLOADER_H
+#define PARALLELS_TSPLIBLOADER_H
+
+#include <istream>
+#include <memory>
+#include <string>
+
+#include "../../DataStructures/DistanceProvider/DistanceProvider.h"
+
+namespace s21 {
+
+// Reader of TSPLIB files with EUC_2D, GEO, ATT and EXPLICIT edge weights. Coordinates give a provider
+// with distances computed on demand, explicit weights give a dense matrix.
+class TsplibLoader {
+public:
+    // Returns nullptr if the file is not a supported TSPLIB instance
+    static std::shared_ptr<DistanceProvider> Load(std::istream &file);
+
+private:
+    static std::shared_ptr<DistanceProvider> LoadCoordinates(std::istream &file, int dimension,
+                                                             EdgeWeightType type);
+    static std::shared_ptr<DistanceProvider> LoadWeights(std::istream &file, int dimension,
+                                                         const std::string &format);
+};
+}  // namespace s21
+
+#endif  // PARALLELS_TSPLIBLOADER_H